@@ -3,7 +3,7 @@ REM Build script for Windows CMD
 REM Equivalent to running 'make'
 
 set CXX=g++
-set CXXFLAGS=-std=c++17 -Wall -Wextra -O2 -I./src -I./src/dfa -I./src/pda -I./src/regexparser -I./src/jsonparser
+set CXXFLAGS=-std=c++17 -pthread -Wall -Wextra -O2 -I./src -I./src/dfa -I./src/pda -I./src/regexparser -I./src/jsonparser
 set TARGET=simulator.exe
 set SRCDIR=src
 set OBJDIR=obj
@@ -32,6 +32,22 @@ echo   Compiling src\AutomataJSON.cpp...
 %CXX% %CXXFLAGS% -c src\AutomataJSON.cpp -o obj\AutomataJSON.o
 if errorlevel 1 goto :error
 
+echo   Compiling src\DirectoryWalker.cpp...
+%CXX% %CXXFLAGS% -c src\DirectoryWalker.cpp -o obj\DirectoryWalker.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\MappedFile.cpp...
+%CXX% %CXXFLAGS% -c src\MappedFile.cpp -o obj\MappedFile.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\VerdictStore.cpp...
+%CXX% %CXXFLAGS% -c src\VerdictStore.cpp -o obj\VerdictStore.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\StreamPipeline.cpp...
+%CXX% %CXXFLAGS% -c src\StreamPipeline.cpp -o obj\StreamPipeline.o
+if errorlevel 1 goto :error
+
 echo   Compiling src\regexparser\RegexParser.cpp...
 %CXX% %CXXFLAGS% -c src\regexparser\RegexParser.cpp -o obj\regexparser\RegexParser.o
 if errorlevel 1 goto :error
@@ -40,17 +56,73 @@ echo   Compiling src\pda\PDAModule.cpp...
 %CXX% %CXXFLAGS% -c src\pda\PDAModule.cpp -o obj\pda\PDAModule.o
 if errorlevel 1 goto :error
 
+echo   Compiling src\pda\FlowTable.cpp...
+%CXX% %CXXFLAGS% -c src\pda\FlowTable.cpp -o obj\pda\FlowTable.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\pda\FlowShards.cpp...
+%CXX% %CXXFLAGS% -c src\pda\FlowShards.cpp -o obj\pda\FlowShards.o
+if errorlevel 1 goto :error
+
 echo   Compiling src\dfa\DFAModule.cpp...
 %CXX% %CXXFLAGS% -c src\dfa\DFAModule.cpp -o obj\dfa\DFAModule.o
 if errorlevel 1 goto :error
 
+echo   Compiling src\dfa\DFAAlgebra.cpp...
+%CXX% %CXXFLAGS% -c src\dfa\DFAAlgebra.cpp -o obj\dfa\DFAAlgebra.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\dfa\DAWG.cpp...
+%CXX% %CXXFLAGS% -c src\dfa\DAWG.cpp -o obj\dfa\DAWG.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\dfa\IOCFilter.cpp...
+%CXX% %CXXFLAGS% -c src\dfa\IOCFilter.cpp -o obj\dfa\IOCFilter.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\dfa\CompiledDFA.cpp...
+%CXX% %CXXFLAGS% -c src\dfa\CompiledDFA.cpp -o obj\dfa\CompiledDFA.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\dfa\VerdictCache.cpp...
+%CXX% %CXXFLAGS% -c src\dfa\VerdictCache.cpp -o obj\dfa\VerdictCache.o
+if errorlevel 1 goto :error
+
 echo   Compiling src\jsonparser\JSONParser.cpp...
 %CXX% %CXXFLAGS% -c src\jsonparser\JSONParser.cpp -o obj\jsonparser\JSONParser.o
 if errorlevel 1 goto :error
 
+echo   Compiling src\jsonparser\DatasetStore.cpp...
+%CXX% %CXXFLAGS% -c src\jsonparser\DatasetStore.cpp -o obj\jsonparser\DatasetStore.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\jsonparser\TraceIdTable.cpp...
+%CXX% %CXXFLAGS% -c src\jsonparser\TraceIdTable.cpp -o obj\jsonparser\TraceIdTable.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\jsonparser\JSONLTokenizer.cpp...
+%CXX% %CXXFLAGS% -c src\jsonparser\JSONLTokenizer.cpp -o obj\jsonparser\JSONLTokenizer.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\jsonparser\CSVReader.cpp...
+%CXX% %CXXFLAGS% -c src\jsonparser\CSVReader.cpp -o obj\jsonparser\CSVReader.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\jsonparser\TraceViewSet.cpp...
+%CXX% %CXXFLAGS% -c src\jsonparser\TraceViewSet.cpp -o obj\jsonparser\TraceViewSet.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\jsonparser\ColumnarDataset.cpp...
+%CXX% %CXXFLAGS% -c src\jsonparser\ColumnarDataset.cpp -o obj\jsonparser\ColumnarDataset.o
+if errorlevel 1 goto :error
+
+echo   Compiling src\jsonparser\TraceStream.cpp...
+%CXX% %CXXFLAGS% -c src\jsonparser\TraceStream.cpp -o obj\jsonparser\TraceStream.o
+if errorlevel 1 goto :error
+
 REM Link object files
 echo   Linking %TARGET%...
-%CXX% obj\main.o obj\AutomataJSON.o obj\regexparser\RegexParser.o obj\pda\PDAModule.o obj\dfa\DFAModule.o obj\jsonparser\JSONParser.o -o %TARGET%
+%CXX% obj\main.o obj\AutomataJSON.o obj\DirectoryWalker.o obj\MappedFile.o obj\VerdictStore.o obj\StreamPipeline.o obj\regexparser\RegexParser.o obj\pda\PDAModule.o obj\pda\FlowTable.o obj\pda\FlowShards.o obj\dfa\DFAModule.o obj\dfa\DFAAlgebra.o obj\dfa\DAWG.o obj\dfa\IOCFilter.o obj\dfa\CompiledDFA.o obj\dfa\VerdictCache.o obj\jsonparser\JSONParser.o obj\jsonparser\DatasetStore.o obj\jsonparser\TraceIdTable.o obj\jsonparser\JSONLTokenizer.o obj\jsonparser\CSVReader.o obj\jsonparser\TraceViewSet.o obj\jsonparser\ColumnarDataset.o obj\jsonparser\TraceStream.o -pthread -o %TARGET%
 if errorlevel 1 goto :error
 
 echo Build complete! Run with: %TARGET%
@@ -2,7 +2,7 @@
 # Equivalent to running 'make'
 
 $CXX = "g++"
-$CXXFLAGS = @("-std=c++17", "-Wall", "-Wextra", "-O2", "-I./src", "-I./src/dfa", "-I./src/pda", "-I./src/regexparser", "-I./src/jsonparser")
+$CXXFLAGS = @("-std=c++17", "-pthread", "-Wall", "-Wextra", "-O2", "-I./src", "-I./src/dfa", "-I./src/pda", "-I./src/regexparser", "-I./src/jsonparser")
 $TARGET = "simulator.exe"
 $SRCDIR = "src"
 $OBJDIR = "obj"
@@ -11,10 +11,28 @@ $OBJDIR = "obj"
 $SOURCES = @(
     "$SRCDIR/main.cpp",
     "$SRCDIR/AutomataJSON.cpp",
+    "$SRCDIR/DirectoryWalker.cpp",
+    "$SRCDIR/MappedFile.cpp",
+    "$SRCDIR/VerdictStore.cpp",
+    "$SRCDIR/StreamPipeline.cpp",
     "$SRCDIR/regexparser/RegexParser.cpp",
     "$SRCDIR/pda/PDAModule.cpp",
+    "$SRCDIR/pda/FlowTable.cpp",
+    "$SRCDIR/pda/FlowShards.cpp",
     "$SRCDIR/dfa/DFAModule.cpp",
-    "$SRCDIR/jsonparser/JSONParser.cpp"
+    "$SRCDIR/dfa/DFAAlgebra.cpp",
+    "$SRCDIR/dfa/DAWG.cpp",
+    "$SRCDIR/dfa/IOCFilter.cpp",
+    "$SRCDIR/dfa/CompiledDFA.cpp",
+    "$SRCDIR/dfa/VerdictCache.cpp",
+    "$SRCDIR/jsonparser/JSONParser.cpp",
+    "$SRCDIR/jsonparser/DatasetStore.cpp",
+    "$SRCDIR/jsonparser/TraceIdTable.cpp",
+    "$SRCDIR/jsonparser/JSONLTokenizer.cpp",
+    "$SRCDIR/jsonparser/CSVReader.cpp",
+    "$SRCDIR/jsonparser/TraceViewSet.cpp",
+    "$SRCDIR/jsonparser/ColumnarDataset.cpp",
+    "$SRCDIR/jsonparser/TraceStream.cpp"
 )
 
 # Create obj directory structure if it doesn't exist
@@ -53,7 +71,7 @@ foreach ($source in $SOURCES) {
 
 # Link object files into executable
 Write-Host "  Linking $TARGET..." -ForegroundColor Yellow
-& $CXX @OBJECTS -o $TARGET
+& $CXX @OBJECTS -pthread -o $TARGET
 if ($LASTEXITCODE -ne 0) {
     Write-Host "Error linking $TARGET" -ForegroundColor Red
     exit 1
@@ -0,0 +1,155 @@
+/**
+ * DirectoryWalker.cpp
+ * Parallel recursive directory traversal on the work-stealing pool
+ */
+
+#include "DirectoryWalker.h"
+
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <filesystem>
+#endif
+
+namespace CS311 {
+
+#ifdef __linux__
+namespace {
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+const size_t DIRENT_BUF_SIZE = 64 * 1024;
+// Children are never followed through symlinks; the root is resolved like any path the user gives
+const int DIR_OPEN_FLAGS = O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC;
+const int ROOT_OPEN_FLAGS = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+} // namespace
+
+// fd == -1: open `path` when the task runs (queued by path because the fd budget was exhausted)
+void DirectoryWalker::visit(Shared& sh, int fd, std::string path) {
+    if (fd == -1) {
+        fd = ::open(path.c_str(), DIR_OPEN_FLAGS);
+        if (fd == -1) { sh.errors.fetch_add(1, std::memory_order_relaxed); return; }
+    } else {
+        sh.queued_fds.fetch_sub(1, std::memory_order_relaxed);
+    }
+    sh.directories.fetch_add(1, std::memory_order_relaxed);
+
+    std::vector<char> buf(DIRENT_BUF_SIZE);
+    std::vector<std::string> names;
+    std::string prefix = (!path.empty() && path.back() == '/') ? path : path + "/";
+    while (true) {
+        long n = ::syscall(SYS_getdents64, fd, buf.data(), buf.size());
+        if (n == 0) break;
+        if (n < 0) { sh.errors.fetch_add(1, std::memory_order_relaxed); break; }
+        for (long off = 0; off < n; ) {
+            auto* d = reinterpret_cast<LinuxDirent64*>(buf.data() + off);
+            off += d->d_reclen;
+            const char* name = d->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) continue;
+
+            unsigned char type = d->d_type;
+            if (type == DT_UNKNOWN) {
+                // Some filesystems do not fill d_type
+                struct stat st;
+                if (::fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0) {
+                    type = S_ISDIR(st.st_mode) ? DT_DIR : DT_REG;
+                }
+            }
+            if (type != DT_DIR) {
+                names.emplace_back(name);
+                continue;
+            }
+            std::string childPath = prefix + name;
+            int childFd = -1;
+            if (sh.queued_fds.load(std::memory_order_relaxed) < MAX_QUEUED_FDS) {
+                childFd = ::openat(fd, name, DIR_OPEN_FLAGS);
+                if (childFd == -1) { sh.errors.fetch_add(1, std::memory_order_relaxed); continue; }
+                sh.queued_fds.fetch_add(1, std::memory_order_relaxed);
+            }
+            Shared* shp = &sh;
+            sh.pool->submit([shp, childFd, childPath]() { visit(*shp, childFd, childPath); });
+        }
+    }
+    ::close(fd);
+
+    if (!names.empty()) {
+        sh.entries.fetch_add(names.size(), std::memory_order_relaxed);
+        (*sh.onBatch)(path, names);
+    }
+}
+
+DirectoryWalker::Stats DirectoryWalker::walk(const std::string& root, ThreadPool& pool, const BatchFn& onBatch) {
+    Shared sh;
+    sh.pool = &pool;
+    sh.onBatch = &onBatch;
+    std::string start = root;
+    while (start.size() > 1 && start.back() == '/') start.pop_back();
+    int fd = ::open(start.c_str(), ROOT_OPEN_FLAGS);
+    if (fd == -1) {
+        Stats failed;
+        failed.errors = 1;
+        failed.root_opened = false;
+        return failed;
+    }
+    sh.queued_fds.fetch_add(1, std::memory_order_relaxed);
+    pool.submit([&sh, fd, start]() { visit(sh, fd, start); });
+    pool.wait();
+    return {sh.directories.load(), sh.entries.load(), sh.errors.load()};
+}
+
+#else
+
+void DirectoryWalker::visit(Shared& sh, int, std::string path) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::directory_iterator it(fs::u8path(path), fs::directory_options::skip_permission_denied, ec);
+    if (ec) { sh.errors.fetch_add(1, std::memory_order_relaxed); return; }
+    sh.directories.fetch_add(1, std::memory_order_relaxed);
+
+    std::vector<std::string> names;
+    for (; it != fs::directory_iterator(); it.increment(ec)) {
+        if (ec) { sh.errors.fetch_add(1, std::memory_order_relaxed); break; }
+        const fs::directory_entry& e = *it;
+        std::string name = e.path().filename().u8string();
+        if (e.is_directory(ec) && !e.is_symlink(ec)) {
+            std::string childPath = e.path().u8string();
+            Shared* shp = &sh;
+            sh.pool->submit([shp, childPath]() { visit(*shp, -1, childPath); });
+        } else {
+            names.push_back(std::move(name));
+        }
+    }
+
+    if (!names.empty()) {
+        sh.entries.fetch_add(names.size(), std::memory_order_relaxed);
+        (*sh.onBatch)(path, names);
+    }
+}
+
+DirectoryWalker::Stats DirectoryWalker::walk(const std::string& root, ThreadPool& pool, const BatchFn& onBatch) {
+    Shared sh;
+    sh.pool = &pool;
+    sh.onBatch = &onBatch;
+    std::error_code ec;
+    if (!std::filesystem::is_directory(std::filesystem::u8path(root), ec)) {
+        Stats failed;
+        failed.errors = 1;
+        failed.root_opened = false;
+        return failed;
+    }
+    pool.submit([&sh, root]() { visit(sh, -1, root); });
+    pool.wait();
+    return {sh.directories.load(), sh.entries.load(), sh.errors.load()};
+}
+
+#endif
+
+} // namespace CS311
@@ -0,0 +1,58 @@
+/**
+ * DirectoryWalker.h
+ * Parallel recursive directory traversal on the work-stealing pool
+ */
+
+#ifndef DIRECTORYWALKER_H
+#define DIRECTORYWALKER_H
+
+#include "ThreadPool.h"
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * One pool task per directory. A task lists its directory in one pass, hands the batch of
+ * non-directory entry names to the callback, and submits every subdirectory as a new task
+ * (which lands on the same worker's deque, so idle workers steal whole subtrees).
+ *
+ * On Linux directories are read with raw getdents64 into a 64 KB buffer and children are
+ * opened with openat() relative to the parent descriptor (no path re-resolution, d_type
+ * avoids a stat per entry). Open descriptors held by queued tasks are capped; beyond the cap
+ * a child is queued by path and opened when it runs. Elsewhere std::filesystem is used.
+ * Symlinks below the root are reported as entries and never followed; the root itself may be
+ * a symlink to a directory.
+ */
+class DirectoryWalker {
+public:
+    struct Stats {
+        uint64_t directories = 0;
+        uint64_t entries = 0;     // non-directory entries passed to the callback
+        uint64_t errors = 0;      // directories that could not be opened or read
+        bool root_opened = true;  // false: `root` is not a readable directory, nothing was walked
+    };
+    // Called concurrently from worker threads with a directory path and its non-directory entries
+    using BatchFn = std::function<void(const std::string& dir, const std::vector<std::string>& names)>;
+
+    static Stats walk(const std::string& root, ThreadPool& pool, const BatchFn& onBatch);
+
+private:
+    struct Shared {
+        ThreadPool* pool;
+        const BatchFn* onBatch;
+        std::atomic<uint64_t> directories{0};
+        std::atomic<uint64_t> entries{0};
+        std::atomic<uint64_t> errors{0};
+        std::atomic<int> queued_fds{0};
+    };
+    static constexpr int MAX_QUEUED_FDS = 256;
+
+    static void visit(Shared& sh, int fd, std::string path);
+};
+
+} // namespace CS311
+
+#endif // DIRECTORYWALKER_H
@@ -0,0 +1,109 @@
+/**
+ * MappedFile.cpp
+ * Read-only view of a file's bytes: mmap for large files, a single pread for small ones
+ */
+
+#include "MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CS311_HAVE_MMAP 1
+#else
+#include <fstream>
+#endif
+
+namespace CS311 {
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        map_base = other.map_base;
+        length = other.length;
+        mapped = other.mapped;
+        opened = other.opened;
+        buffer = std::move(other.buffer);
+        other.map_base = nullptr;
+        other.length = 0;
+        other.mapped = false;
+        other.opened = false;
+    }
+    return *this;
+}
+
+#ifdef CS311_HAVE_MMAP
+
+bool MappedFile::open(const std::string& path, Access access, size_t smallFileBytes) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+
+    if (size <= smallFileBytes) {
+        buffer.resize(size);
+        size_t done = 0;
+        while (done < size) {
+            ssize_t n = ::pread(fd, buffer.data() + done, size - done, (off_t)done);
+            if (n <= 0) break; // file shrank or read error: keep what was read
+            done += (size_t)n;
+        }
+        buffer.resize(done);
+        length = done;
+    } else {
+        void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        ::madvise(p, size, access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+        map_base = p;
+        length = size;
+        mapped = true;
+    }
+    ::close(fd); // a mapping stays valid after its descriptor is closed
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped && map_base) ::munmap(map_base, length);
+    map_base = nullptr;
+    length = 0;
+    mapped = false;
+    opened = false;
+    std::vector<char>().swap(buffer);
+}
+
+#else
+
+bool MappedFile::open(const std::string& path, Access, size_t) {
+    close();
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) return false;
+    std::streamsize size = in.tellg();
+    if (size < 0) return false;
+    in.seekg(0);
+    buffer.resize((size_t)size);
+    in.read(buffer.data(), size);
+    length = (size_t)in.gcount();
+    buffer.resize(length);
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+    length = 0;
+    opened = false;
+    std::vector<char>().swap(buffer);
+}
+
+#endif
+
+} // namespace CS311
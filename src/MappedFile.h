@@ -0,0 +1,56 @@
+/**
+ * MappedFile.h
+ * Read-only view of a file's bytes: mmap for large files, a single pread for small ones
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+namespace CS311 {
+
+/**
+ * Opens a regular file and exposes its contents as one contiguous read-only range.
+ * Files above `smallFileBytes` are mapped (PROT_READ, MAP_PRIVATE) with the requested
+ * madvise hint, so scanning them costs no copies; smaller files are read with pread into
+ * an owned buffer, which is cheaper than setting up and tearing down a mapping.
+ * On platforms without mmap the whole file is read into the buffer.
+ */
+class MappedFile {
+public:
+    enum class Access { Sequential, Random };
+    static constexpr size_t DEFAULT_SMALL_FILE_BYTES = 64 * 1024;
+
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Returns false (and leaves the object empty) if the path is not a readable regular file
+    bool open(const std::string& path, Access access = Access::Sequential,
+              size_t smallFileBytes = DEFAULT_SMALL_FILE_BYTES);
+    void close();
+
+    const char* data() const { return mapped ? static_cast<const char*>(map_base) : buffer.data(); }
+    size_t size() const { return length; }
+    std::string_view view() const { return std::string_view(data(), length); }
+    bool isOpen() const { return opened; }
+    bool isMapped() const { return mapped; }
+
+private:
+    void* map_base = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+    bool opened = false;
+    std::vector<char> buffer;
+};
+
+} // namespace CS311
+
+#endif // MAPPEDFILE_H
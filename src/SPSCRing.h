@@ -0,0 +1,73 @@
+/**
+ * SPSCRing.h
+ * Bounded lock-free ring buffer for exactly one producer thread and one consumer thread
+ */
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * Power-of-two slot array indexed by free-running head/tail counters. Each side keeps a
+ * private copy of the other side's counter and re-reads the shared one only when the copy
+ * says the ring is full (producer) or empty (consumer), so in steady state the two cores
+ * exchange a cache line per batch rather than per item. The counters live on separate cache
+ * lines to avoid false sharing.
+ */
+template <typename T>
+class SPSCRing {
+public:
+    explicit SPSCRing(size_t capacity) {
+        size_t n = 2;
+        while (n < capacity) n *= 2;
+        slots.resize(n);
+        mask = n - 1;
+    }
+    SPSCRing(const SPSCRing&) = delete;
+    SPSCRing& operator=(const SPSCRing&) = delete;
+
+    // Producer: false if the ring is full
+    bool tryPush(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head_cache > mask) {
+            head_cache = head.load(std::memory_order_acquire);
+            if (t - head_cache > mask) return false;
+        }
+        slots[t & mask] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: moves up to `max` items into `out`, returns how many
+    size_t tryPopBatch(T* out, size_t max) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (tail_cache == h) {
+            tail_cache = tail.load(std::memory_order_acquire);
+            if (tail_cache == h) return 0;
+        }
+        size_t n = std::min(tail_cache - h, max);
+        for (size_t i = 0; i < n; ++i) out[i] = slots[(h + i) & mask];
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    std::vector<T> slots;
+    size_t mask = 0;
+    alignas(64) std::atomic<size_t> head{0};  // next slot to read (written by the consumer)
+    size_t tail_cache = 0;                    // consumer's copy of tail
+    alignas(64) std::atomic<size_t> tail{0};  // next slot to write (written by the producer)
+    size_t head_cache = 0;                    // producer's copy of head
+};
+
+} // namespace CS311
+
+#endif // SPSCRING_H
@@ -0,0 +1,169 @@
+/**
+ * StreamPipeline.cpp
+ * Constant-memory pipeline: trace records flow batch by batch through filename DFA, content DFA
+ * and PDA validation
+ */
+
+#include "StreamPipeline.h"
+#include "TraceStream.h"
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+
+namespace CS311 {
+
+namespace {
+// Same labelling as the staged filename datasets: a category containing "malicious"
+bool labelledMalicious(std::string_view category) {
+    static const char word[] = "malicious";
+    const size_t n = sizeof(word) - 1;
+    for (size_t i = 0; i + n <= category.size(); ++i) {
+        size_t k = 0;
+        while (k < n && std::tolower((unsigned char)category[i + k]) == word[k]) k++;
+        if (k == n) return true;
+    }
+    return false;
+}
+} // namespace
+
+StreamPipeline::StreamPipeline(DFAModule& dfa, PDAModule& pda)
+    : dfa(dfa), pda(pda), filename_samples(SAMPLE_SIZE), trace_samples(SAMPLE_SIZE) {}
+
+bool StreamPipeline::run(const std::string& path, std::ostream& rejected) {
+    TraceStream stream;
+    if (!stream.open(path)) {
+        std::cerr << "[ERROR] Could not open trace stream: " << path << std::endl;
+        return false;
+    }
+    std::cout << "[INFO] Streaming traces: " << (path == "-" ? std::string("(stdin)") : path) << std::endl;
+    auto start = std::chrono::high_resolution_clock::now();
+    uint64_t records_before = metrics.records;
+    while (stream.next()) {
+        metrics.batches++;
+        for (const TraceView& t : stream.batch().records()) processRecord(t, rejected);
+    }
+    metrics.bytes += stream.bytesRead();
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+    metrics.total_execution_time_ms += ms;
+    std::cout << "[SUCCESS] Streamed " << (metrics.records - records_before) << " traces"
+              << (stream.isCSV() ? " (CSV)" : "") << " in " << ms << " ms" << std::endl;
+    return true;
+}
+
+void StreamPipeline::processRecord(const TraceView& t, std::ostream& rejected) {
+    metrics.records++;
+
+    // Stage 1: filename DFA on the trace id
+    name_buffer.assign(t.trace_id);
+    bool suspicious = dfa.isSuspiciousFilename(name_buffer);
+    bool malicious_label = labelledMalicious(t.category);
+    if (suspicious) {
+        metrics.filename_suspicious++;
+        if (malicious_label) metrics.filename_true_positives++; else metrics.filename_false_positives++;
+    } else if (malicious_label) {
+        metrics.filename_false_negatives++;
+    }
+    if (FilenameSample* s = filename_samples.offer()) {
+        s->name = name_buffer;
+        s->suspicious = suspicious;
+        s->matched.clear();
+        if (suspicious) dfa.testFilenameWithDFA(name_buffer, s->matched);
+    }
+    if (!suspicious) return;
+
+    // Stage 2: content DFA, only behind a suspicious name
+    if (t.content.empty() || !dfa.scanContent(t.content)) return;
+    metrics.content_malicious++;
+
+    // Stage 3: PDA validation of the packet sequence
+    int depth = 0;
+    bool accepted = pda.validateTrace(t, depth);
+    metrics.pda_validated++;
+    metrics.total_stack_depth += (uint64_t)std::max(depth, 0);
+    metrics.max_stack_depth = std::max(metrics.max_stack_depth, depth);
+    if (t.valid) metrics.pda_valid_labelled++;
+    if (accepted && t.valid) metrics.correctly_accepted++;
+    else if (!accepted && !t.valid) metrics.correctly_rejected++;
+    else if (accepted) metrics.pda_false_positives++;
+    else metrics.pda_false_negatives++;
+    if (!accepted) {
+        metrics.pda_rejected++;
+        rejected << t.trace_id << "\n";
+    }
+    if (TraceSample* s = trace_samples.offer()) {
+        s->trace_id.assign(t.trace_id);
+        s->description.assign(t.description);
+        s->labelled_valid = t.valid;
+        s->accepted = accepted;
+    }
+}
+
+void StreamPipeline::generateReport() const {
+    std::cout << "\n╔═══════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║          STREAMING PIPELINE - RESULTS                     ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════════╝" << std::endl;
+
+    std::cout << "\n[SAMPLE FILENAME RESULTS (RANDOMIZED)]" << std::endl;
+    size_t n = 0;
+    for (const auto& s : filename_samples.sample()) {
+        std::ostringstream id;
+        id << "File_" << std::setw(3) << std::setfill('0') << (++n);
+        std::cout << "[" << id.str() << "]  \"" << s.name << "\" → " << (s.suspicious ? "MALICIOUS" : "BENIGN");
+        if (s.suspicious && !s.matched.empty()) std::cout << " (matched: " << s.matched << ")";
+        std::cout << std::endl;
+    }
+
+    std::cout << "\n[SAMPLE TCP TRACE RESULTS (RANDOMIZED)]" << std::endl;
+    n = 0;
+    for (const auto& s : trace_samples.sample()) {
+        std::string reason;
+        if (!s.accepted && s.labelled_valid) reason = " (unexpected rejection)";
+        else if (s.accepted && !s.labelled_valid) reason = " (unexpected acceptance)";
+        else if (!s.accepted && !s.description.empty()) reason = " (" + s.description + ")";
+        std::ostringstream id;
+        id << "Trace_" << std::setw(3) << std::setfill('0') << (++n);
+        std::cout << "[" << id.str() << "] " << (s.trace_id.empty() ? "(no-id)" : s.trace_id)
+                  << ": " << (s.accepted ? "VALID" : "INVALID") << reason << std::endl;
+    }
+
+    const StreamMetrics& m = metrics;
+    std::cout << "\n[PIPELINE SUMMARY]" << std::endl;
+    std::cout << "  Records streamed: " << m.records << " (" << m.batches << " batches, "
+              << (m.bytes / 1024) << " KB)" << std::endl;
+    std::cout << "  Filename DFA flagged: " << m.filename_suspicious << std::endl;
+    std::cout << "  Content DFA flagged within suspicious: " << m.content_malicious << std::endl;
+    std::cout << "  PDA validated: " << m.pda_validated << std::endl;
+    std::cout << "  Final malicious (PDA rejected): " << m.pda_rejected << std::endl;
+
+    std::cout << "\n[DETECTION METRICS]" << std::endl;
+    std::cout << "  True Positives:   " << m.filename_true_positives << std::endl;
+    std::cout << "  False Positives:  " << m.filename_false_positives << std::endl;
+    std::cout << "  False Negatives:  " << m.filename_false_negatives << std::endl;
+
+    uint64_t invalid_labelled = m.pda_validated - m.pda_valid_labelled;
+    std::cout << "\n[VALIDATION METRICS]" << std::endl;
+    std::cout << "  ✓ Valid accepted:       " << m.correctly_accepted << " / " << m.pda_valid_labelled << std::endl;
+    std::cout << "  ✓ Invalid rejected:     " << m.correctly_rejected << " / " << invalid_labelled << std::endl;
+    std::cout << "  ✗ False positives:      " << m.pda_false_positives << std::endl;
+    std::cout << "  ✗ False negatives:      " << m.pda_false_negatives << std::endl;
+    if (m.pda_validated > 0) {
+        std::cout << "  Validation accuracy:    "
+                  << 100.0 * (double)(m.correctly_accepted + m.correctly_rejected) / (double)m.pda_validated << "%" << std::endl;
+    }
+
+    std::cout << "\n[STACK METRICS]" << std::endl;
+    std::cout << "  Average stack depth:    "
+              << (m.pda_validated > 0 ? (double)m.total_stack_depth / (double)m.pda_validated : 0.0) << std::endl;
+    std::cout << "  Maximum stack depth:    " << m.max_stack_depth << std::endl;
+
+    std::cout << "\n[PERFORMANCE]" << std::endl;
+    std::cout << "  Total time:             " << m.total_execution_time_ms << " ms" << std::endl;
+    if (m.total_execution_time_ms > 0) {
+        std::cout << "  Throughput:             " << (uint64_t)(m.records * 1000.0 / m.total_execution_time_ms)
+                  << " records/s" << std::endl;
+    }
+}
+
+} // namespace CS311
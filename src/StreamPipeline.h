@@ -0,0 +1,93 @@
+/**
+ * StreamPipeline.h
+ * Constant-memory pipeline: trace records flow batch by batch through filename DFA, content DFA
+ * and PDA validation
+ */
+
+#ifndef STREAMPIPELINE_H
+#define STREAMPIPELINE_H
+
+#include "Utils.h"
+#include "DFAModule.h"
+#include "PDAModule.h"
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace CS311 {
+
+// Uniform sample of at most `capacity` items from a stream of unknown length (Algorithm R)
+template <typename T>
+class ReservoirSample {
+public:
+    explicit ReservoirSample(size_t capacity) : capacity(capacity), gen(std::random_device{}()) {}
+    // Counts one more stream item; returns the slot it should be written to, or nullptr if the
+    // item is not sampled (so callers build the item only when it is kept)
+    T* offer() {
+        seen_items++;
+        if (items.size() < capacity) { items.emplace_back(); return &items.back(); }
+        uint64_t j = std::uniform_int_distribution<uint64_t>(0, seen_items - 1)(gen);
+        return j < capacity ? &items[(size_t)j] : nullptr;
+    }
+    const std::vector<T>& sample() const { return items; }
+    uint64_t seenCount() const { return seen_items; }
+
+private:
+    size_t capacity;
+    uint64_t seen_items = 0;
+    std::vector<T> items;
+    std::mt19937_64 gen;
+};
+
+/**
+ * Streaming counterpart of the gated batch pipeline in main.cpp. Each record read by a
+ * TraceStream is decided on its own: its trace_id through the filename DFAs, then (if
+ * suspicious) its content through the content DFAs, then (if content-malicious) its packet
+ * sequence through the PDA; PDA-rejected ids are written out immediately. Metrics are running
+ * totals and the randomized report samples are reservoirs, so memory stays at one read buffer
+ * plus the automata whatever the input size.
+ *
+ * Unlike the batch pipeline there is no join across sources: a record is gated by its own
+ * name and content only, and every record counts (no de-duplication of trace ids).
+ * The DFA and PDA modules must be built before run().
+ */
+class StreamPipeline {
+public:
+    static constexpr size_t SAMPLE_SIZE = 5;
+
+    StreamPipeline(DFAModule& dfa, PDAModule& pda);
+
+    // Stream one source ("-" = standard input); rejected trace ids are appended to `rejected`.
+    // Returns false if the source cannot be opened.
+    bool run(const std::string& path, std::ostream& rejected);
+    void generateReport() const;
+    const StreamMetrics& getMetrics() const { return metrics; }
+
+private:
+    struct FilenameSample {
+        std::string name;
+        std::string matched;
+        bool suspicious = false;
+    };
+    struct TraceSample {
+        std::string trace_id;
+        std::string description;
+        bool labelled_valid = false;
+        bool accepted = false;
+    };
+
+    DFAModule& dfa;
+    PDAModule& pda;
+    StreamMetrics metrics;
+    ReservoirSample<FilenameSample> filename_samples;
+    ReservoirSample<TraceSample> trace_samples;
+    std::string name_buffer;   // reused for the std::string DFA entry points
+
+    void processRecord(const TraceView& t, std::ostream& rejected);
+};
+
+} // namespace CS311
+
+#endif // STREAMPIPELINE_H
@@ -0,0 +1,168 @@
+/**
+ * ThreadPool.h
+ * Work-stealing thread pool shared by the parallel pipeline stages
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * Each worker owns a deque: it pops its own tasks LIFO (cache-warm) and, when empty,
+ * steals FIFO from the other workers. Tasks submitted from inside a worker go to that
+ * worker's own deque, so recursive fan-out (e.g. directory walks) stays local until
+ * someone else runs dry. wait() blocks until every submitted task, including tasks
+ * spawned by tasks, has finished; the first exception thrown by a task is rethrown there.
+ *
+ * wait() must be called from outside the pool.
+ */
+class ThreadPool {
+private:
+    struct Queue {
+        std::mutex m;
+        std::deque<std::function<void()>> tasks;
+    };
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex state_m;
+    std::condition_variable work_cv;   // signalled on submit/stop
+    std::condition_variable done_cv;   // signalled when pending reaches zero
+    std::atomic<size_t> queued{0};     // tasks sitting in a deque
+    std::atomic<size_t> pending{0};    // tasks submitted but not yet finished
+    std::atomic<size_t> next_queue{0}; // round-robin target for external submits
+    bool stopping = false;
+    std::exception_ptr first_error;
+
+    static ThreadPool*& currentPool() { static thread_local ThreadPool* p = nullptr; return p; }
+    static size_t& currentIndex() { static thread_local size_t i = 0; return i; }
+
+    bool tryTake(size_t self, std::function<void()>& task) {
+        {
+            Queue& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.m);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        for (size_t k = 1; k < queues.size(); ++k) {
+            Queue& victim = *queues[(self + k) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.m);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t self) {
+        currentPool() = this;
+        currentIndex() = self;
+        std::function<void()> task;
+        while (true) {
+            if (!tryTake(self, task)) {
+                std::unique_lock<std::mutex> lock(state_m);
+                work_cv.wait(lock, [&]{ return stopping || queued.load() > 0; });
+                if (stopping && queued.load() == 0) return;
+                continue;
+            }
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state_m);
+                if (!first_error) first_error = std::current_exception();
+            }
+            task = nullptr;
+            if (pending.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(state_m);
+                done_cv.notify_all();
+            }
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency()) {
+        threads = std::max<size_t>(1, threads);
+        for (size_t i = 0; i < threads; ++i) queues.push_back(std::make_unique<Queue>());
+        for (size_t i = 0; i < threads; ++i) workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(state_m);
+            stopping = true;
+        }
+        work_cv.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    void submit(std::function<void()> task) {
+        size_t target = (currentPool() == this) ? currentIndex()
+                                                : next_queue.fetch_add(1) % queues.size();
+        pending.fetch_add(1);
+        {
+            // Count before publishing so a thief can never drive `queued` below zero
+            std::lock_guard<std::mutex> lock(state_m);
+            queued.fetch_add(1);
+        }
+        {
+            std::lock_guard<std::mutex> lock(queues[target]->m);
+            queues[target]->tasks.push_back(std::move(task));
+        }
+        work_cv.notify_one();
+    }
+
+    // Block until all submitted work (including nested submits) has completed
+    void wait() {
+        std::unique_lock<std::mutex> lock(state_m);
+        done_cv.wait(lock, [&]{ return pending.load() == 0; });
+        if (first_error) {
+            std::exception_ptr e = first_error;
+            first_error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    // Split [0, n) into contiguous chunks of `grain` items and run fn(chunk, begin, end) on the
+    // pool. Chunk indices are stable, so callers can keep one accumulator per chunk and merge
+    // them in index order for results identical to a sequential pass.
+    template <typename Fn>
+    size_t parallelFor(size_t n, size_t grain, Fn fn) {
+        grain = std::max<size_t>(1, grain);
+        size_t chunks = (n + grain - 1) / grain;
+        for (size_t c = 0; c < chunks; ++c) {
+            size_t begin = c * grain;
+            size_t end = std::min(n, begin + grain);
+            submit([fn, c, begin, end]() { fn(c, begin, end); });
+        }
+        wait();
+        return chunks;
+    }
+};
+
+} // namespace CS311
+
+#endif // THREADPOOL_H
@@ -7,14 +7,16 @@
 #define UTILS_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 #include <map>
-#include <stack>
 #include <utility>
 #include <iostream>
 #include <chrono>      // ADD THIS
 #include <thread> 
+#include <cstdint>
+#include <cstring>
 
 namespace CS311 {
 
@@ -138,19 +140,67 @@ struct DFA {
     }
 };
 
+// Packet alphabet of the handshake PDA; packets are interned to one byte each at load time
+enum class PacketToken : uint8_t { SYN, SYN_ACK, ACK, DATA, FIN, RST, OTHER };
+
+inline PacketToken packetToken(std::string_view packet) {
+    switch (packet.size()) {
+    case 3:
+        if (packet == "SYN") return PacketToken::SYN;
+        if (packet == "ACK") return PacketToken::ACK;
+        if (packet == "FIN") return PacketToken::FIN;
+        if (packet == "RST") return PacketToken::RST;
+        break;
+    case 4:
+        if (packet == "DATA") return PacketToken::DATA;
+        break;
+    case 7:
+        if (packet == "SYN-ACK") return PacketToken::SYN_ACK;
+        break;
+    }
+    return PacketToken::OTHER;
+}
+
+// Stack alphabet of the handshake PDA; BOTTOM marks the empty stack
+enum class StackSymbol : uint8_t { BOTTOM, SYN, SYN_ACK };
+
+// Compiled PDA: transitions are one flat (state, input token, stack top) table filled by
+// PDAModule::buildPDA, and the stack is a fixed-capacity array of StackSymbols, so a packet
+// step is a table load plus at most a push or a pop, with no allocation
 struct PDA {
+    static constexpr size_t TOKENS = 7;          // PacketToken values
+    static constexpr size_t SYMBOLS = 3;         // StackSymbol values
+    static constexpr int STACK_CAPACITY = 32;    // symbols above BOTTOM
+    // Outcome of one table entry; `note` indexes PDAModule's operation descriptions
+    struct Step {
+        uint8_t next_state;
+        uint8_t pops;
+        StackSymbol push;     // BOTTOM: push nothing
+        uint8_t note;
+        bool ok;              // false: the packet is rejected
+        Step() : next_state(0), pops(0), push(StackSymbol::BOTTOM), note(0), ok(false) {}
+    };
+
     std::vector<State> states;
-    std::stack<std::string> pda_stack;
+    std::vector<Step> table;      // index(state, token, top); empty until the PDA is built
     int current_state;
     int start_state;
     std::set<int> accepting_states;
-    PDA() : current_state(0), start_state(0) { pda_stack.push("BOTTOM"); }
-    void reset() { current_state = start_state; while (!pda_stack.empty()) pda_stack.pop(); pda_stack.push("BOTTOM"); }
-    void push(const std::string& symbol) { pda_stack.push(symbol); }
-    std::string pop() { if (pda_stack.size() > 1) { std::string top = pda_stack.top(); pda_stack.pop(); return top; } return ""; }
-    std::string peek() const { return pda_stack.empty() ? "" : pda_stack.top(); }
-    bool isAccepting() const { return accepting_states.count(current_state) > 0 && pda_stack.size() == 1; }
-    int getStackDepth() const { return (int)pda_stack.size() - 1; }
+    uint64_t accepting_mask;      // bit per state of accepting_states, set with the table
+    StackSymbol stack[STACK_CAPACITY + 1];
+    int depth;                    // symbols above BOTTOM (stack[0])
+    PDA() : current_state(0), start_state(0), accepting_mask(0), depth(0) { stack[0] = StackSymbol::BOTTOM; }
+    static size_t index(int state, PacketToken token, StackSymbol top) {
+        return ((size_t)state * TOKENS + (size_t)token) * SYMBOLS + (size_t)top;
+    }
+    int stateCount() const { return (int)(table.size() / (TOKENS * SYMBOLS)); }
+    void reset() { current_state = start_state; depth = 0; }
+    bool push(StackSymbol symbol) { if (depth == STACK_CAPACITY) return false; stack[++depth] = symbol; return true; }
+    void pop(int n) { depth = n < depth ? depth - n : 0; }
+    StackSymbol peek() const { return stack[depth]; }
+    bool isAcceptingState(int state) const { return state >= 0 && state < 64 && ((accepting_mask >> state) & 1); }
+    bool isAccepting() const { return depth == 0 && isAcceptingState(current_state); }
+    int getStackDepth() const { return depth; }
 };
 
 struct FilenameEntry {
@@ -162,6 +212,16 @@ struct FilenameEntry {
     FilenameEntry() : is_malicious(true) {}
 };
 
+// Content verdict for a real file scanned in scan mode
+struct FileContentResult {
+    bool readable;
+    bool malicious;
+    bool mapped;            // true: mmap path, false: pread/buffered path
+    uint64_t bytes_scanned; // may stop short of the file size once the verdict is certain
+    std::string matched_pattern;
+    FileContentResult() : readable(false), malicious(false), mapped(false), bytes_scanned(0) {}
+};
+
 struct TCPTrace {
     std::string trace_id;
     std::vector<std::string> sequence;
@@ -173,13 +233,43 @@ struct TCPTrace {
     TCPTrace() : valid(false) {}
 };
 
+// Packets of one TraceView: a slice of the owning TraceViewSet's packet array and, when the
+// set interned them, the matching slice of its token array
+struct PacketRange {
+    const std::string_view* first;
+    const std::string_view* last;
+    const PacketToken* token_first;
+    PacketRange() : first(nullptr), last(nullptr), token_first(nullptr) {}
+    PacketRange(const std::string_view* f, const std::string_view* l, const PacketToken* t = nullptr) : first(f), last(l), token_first(t) {}
+    const std::string_view* begin() const { return first; }
+    const std::string_view* end() const { return last; }
+    size_t size() const { return (size_t)(last - first); }
+    bool empty() const { return first == last; }
+    // Interned tokens (size() of them), or nullptr if the range only has the raw packets
+    const PacketToken* tokens() const { return token_first; }
+};
+
+// TCPTrace whose fields point into a mapped dataset file (or its arena for decoded values);
+// valid only while the TraceViewSet that produced it is alive
+struct TraceView {
+    std::string_view trace_id;
+    PacketRange sequence;
+    bool valid;
+    std::string_view description;
+    std::string_view category;
+    std::string_view content;
+    TraceView() : valid(false) {}
+};
+
 struct DFAMetrics {
     int total_patterns;
     int total_nfa_states;
     int total_dfa_states_before_min;
     int total_dfa_states_after_min;
     double state_reduction_min_percent;
+    int redundant_patterns;
     int filenames_tested;
+    int extension_fast_path;
     int true_positives;
     int false_positives;
     int false_negatives;
@@ -187,7 +277,7 @@ struct DFAMetrics {
     double avg_matching_time_ms;
     double total_execution_time_ms;
     int estimated_memory_kb;
-    DFAMetrics() : total_patterns(0), total_nfa_states(0), total_dfa_states_before_min(0), total_dfa_states_after_min(0), state_reduction_min_percent(0), filenames_tested(0), true_positives(0), false_positives(0), false_negatives(0), detection_accuracy(0), avg_matching_time_ms(0), total_execution_time_ms(0), estimated_memory_kb(0) {}
+    DFAMetrics() : total_patterns(0), total_nfa_states(0), total_dfa_states_before_min(0), total_dfa_states_after_min(0), state_reduction_min_percent(0), redundant_patterns(0), filenames_tested(0), extension_fast_path(0), true_positives(0), false_positives(0), false_negatives(0), detection_accuracy(0), avg_matching_time_ms(0), total_execution_time_ms(0), estimated_memory_kb(0) {}
 };
 
 struct PDAMetrics {
@@ -206,6 +296,45 @@ struct PDAMetrics {
     PDAMetrics() : total_traces(0), valid_traces(0), invalid_traces(0), correctly_accepted(0), correctly_rejected(0), false_positives(0), false_negatives(0), validation_accuracy(0), avg_stack_depth(0), max_stack_depth(0), avg_validation_time_ms(0), total_execution_time_ms(0) {}
 };
 
+// Running totals of the streaming pipeline (filename DFA → content DFA → PDA per record)
+struct StreamMetrics {
+    uint64_t records;
+    uint64_t bytes;
+    uint64_t batches;
+    uint64_t filename_suspicious;
+    uint64_t filename_true_positives;
+    uint64_t filename_false_positives;
+    uint64_t filename_false_negatives;
+    uint64_t content_malicious;
+    uint64_t pda_validated;
+    uint64_t pda_valid_labelled;
+    uint64_t correctly_accepted;
+    uint64_t correctly_rejected;
+    uint64_t pda_false_positives;
+    uint64_t pda_false_negatives;
+    uint64_t pda_rejected;
+    uint64_t total_stack_depth;
+    int max_stack_depth;
+    double total_execution_time_ms;
+    StreamMetrics() : records(0), bytes(0), batches(0), filename_suspicious(0), filename_true_positives(0), filename_false_positives(0), filename_false_negatives(0), content_malicious(0), pda_validated(0), pda_valid_labelled(0), correctly_accepted(0), correctly_rejected(0), pda_false_positives(0), pda_false_negatives(0), pda_rejected(0), total_stack_depth(0), max_stack_depth(0), total_execution_time_ms(0) {}
+};
+
+// Incremental per-connection validation (PDAModule::replayFlows, FlowShards)
+struct FlowMetrics {
+    uint64_t traces;
+    uint64_t packets;
+    uint64_t accepted;
+    uint64_t rejected;
+    uint64_t untracked;
+    uint64_t mismatches;     // flow verdict differs from validating the whole trace
+    uint64_t evictions;
+    size_t peak_flows;
+    size_t memory_bytes;     // flow tables (and rings, when sharded)
+    size_t shards;
+    double total_execution_time_ms;
+    FlowMetrics() : traces(0), packets(0), accepted(0), rejected(0), untracked(0), mismatches(0), evictions(0), peak_flows(0), memory_bytes(0), shards(1), total_execution_time_ms(0) {}
+};
+
 inline void printSeparator(int length = 60) { std::cout << std::string(length, '=') << std::endl; }
 inline void printHeader(const std::string& title) {
     std::cout << "\n";
@@ -232,6 +361,60 @@ inline std::string escapeDotLabel(const std::string& s) {
     return out;
 }
 
+// 64-bit finalizer (MurmurHash3 fmix64): full avalanche of a 64-bit word
+inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 33; x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33; x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Fast non-cryptographic 64-bit hash of a byte range (8 bytes per step).
+// Used for filter/cache keys; values depend on host endianness.
+inline uint64_t hashBytes64(const void* data, size_t len, uint64_t seed = 0) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed ^ (len * 0x9e3779b97f4a7c15ULL);
+    while (len >= 8) {
+        uint64_t k; std::memcpy(&k, p, 8);
+        h ^= mix64(k);
+        h = ((h << 27) | (h >> 37)) * 0x9e3779b97f4a7c15ULL + 0x52dce729ULL;
+        p += 8; len -= 8;
+    }
+    uint64_t tail = 0;
+    if (len) std::memcpy(&tail, p, len);
+    h ^= mix64(tail ^ 0x2545f4914f6cdd1dULL);
+    return mix64(h);
+}
+inline uint64_t hashString64(std::string_view s, uint64_t seed = 0) { return hashBytes64(s.data(), s.size(), seed); }
+
+// Fixed-size bit set over dense indices (interned ids, record numbers); 64 bits per word
+struct Bitmap {
+    std::vector<uint64_t> words;
+    size_t bits = 0;
+
+    Bitmap() = default;
+    explicit Bitmap(size_t n) : words((n + 63) / 64, 0), bits(n) {}
+    size_t size() const { return bits; }
+    void set(size_t i) { words[i >> 6] |= 1ULL << (i & 63); }
+    bool test(size_t i) const { return i < bits && ((words[i >> 6] >> (i & 63)) & 1); }
+    size_t count() const {
+        size_t n = 0;
+        for (uint64_t w : words) {
+#if defined(__GNUC__) || defined(__clang__)
+            n += (size_t)__builtin_popcountll(w);
+#else
+            for (; w; w &= w - 1) n++;
+#endif
+        }
+        return n;
+    }
+    // Intersection; indices beyond the shorter operand end up clear
+    Bitmap& operator&=(const Bitmap& o) {
+        for (size_t i = 0; i < words.size(); ++i) words[i] &= i < o.words.size() ? o.words[i] : 0;
+        return *this;
+    }
+};
+
 } // namespace CS311
 
 #endif // UTILS_H
@@ -0,0 +1,167 @@
+/**
+ * VerdictStore.cpp
+ * On-disk, append-only store of per-record verdicts reused across pipeline runs
+ */
+
+#include "VerdictStore.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace CS311 {
+
+namespace {
+const char MAGIC[4] = { 'V', 'S', 'T', 'O' };
+const uint32_t FORMAT_VERSION = 1;
+const size_t HEADER_BYTES = 16;
+const size_t MIN_COMPACT_RECORDS = 1024;
+
+void writeHeader(std::ofstream& out) {
+    uint32_t fields[3] = { FORMAT_VERSION, (uint32_t)sizeof(VerdictStore::Record), 0 };
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+}
+} // namespace
+
+bool VerdictStore::open(const std::string& path, uint64_t patternVersion) {
+    file_path = path;
+    version = patternVersion;
+    mapped.close();
+    mapped_index.clear();
+    fresh.clear();
+    mapped_records = 0;
+    stale = 0;
+    hit_count = miss_count = 0;
+
+    std::ifstream probe(path, std::ios::binary);
+    if (!probe.is_open()) return true; // first run: nothing stored yet
+    probe.close();
+    // Lookups jump around the file, so ask for random-access paging
+    if (!mapped.open(path, MappedFile::Access::Random)) return false;
+    uint32_t fields[3] = {};
+    if (mapped.size() < HEADER_BYTES || std::memcmp(mapped.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        mapped.close();
+        return false;
+    }
+    std::memcpy(fields, mapped.data() + sizeof(MAGIC), sizeof(fields));
+    if (fields[0] != FORMAT_VERSION || fields[1] != sizeof(Record)) {
+        mapped.close();
+        return false;
+    }
+    // A torn final record (interrupted append) is ignored
+    mapped_records = (mapped.size() - HEADER_BYTES) / sizeof(Record);
+    mapped_index.reserve(mapped_records);
+    for (size_t i = 0; i < mapped_records; ++i) {
+        Record r = mappedRecord(i);
+        if (r.pattern_version != version) { stale++; continue; }
+        auto ins = mapped_index.emplace(Key{ r.name_hash, r.content_hash }, i);
+        if (!ins.second) { ins.first->second = i; stale++; } // later record overrides
+    }
+    return true;
+}
+
+VerdictStore::Record VerdictStore::mappedRecord(size_t i) const {
+    Record r;
+    std::memcpy(&r, mapped.data() + HEADER_BYTES + i * sizeof(Record), sizeof(Record));
+    return r;
+}
+
+const VerdictStore::Record* VerdictStore::find(uint64_t nameHash, uint64_t contentHash) {
+    Key k{ nameHash, contentHash };
+    auto f = fresh.find(k);
+    if (f != fresh.end()) { hit_count++; return &f->second; }
+    auto m = mapped_index.find(k);
+    if (m == mapped_index.end()) { miss_count++; return nullptr; }
+    // Promote into `fresh` unchanged so the returned pointer stays valid; it is only
+    // rewritten if the caller later upserts it
+    hit_count++;
+    Record& r = fresh.emplace(k, mappedRecord(m->second)).first->second;
+    return &r;
+}
+
+VerdictStore::Record& VerdictStore::upsert(uint64_t nameHash, uint64_t contentHash) {
+    Key k{ nameHash, contentHash };
+    auto f = fresh.find(k);
+    if (f != fresh.end()) return f->second;
+    auto m = mapped_index.find(k);
+    Record r;
+    if (m != mapped_index.end()) {
+        r = mappedRecord(m->second);
+    } else {
+        std::memset(&r, 0, sizeof(r));
+        r.name_hash = nameHash;
+        r.content_hash = contentHash;
+        r.pattern_version = version;
+    }
+    return fresh.emplace(k, r).first->second;
+}
+
+bool VerdictStore::flush() {
+    if (file_path.empty()) return false;
+    // Records that differ from what is already on disk
+    std::vector<Record> changed;
+    size_t superseded = 0;
+    for (const auto& kv : fresh) {
+        auto m = mapped_index.find(kv.first);
+        if (m != mapped_index.end()) {
+            Record old = mappedRecord(m->second);
+            if (std::memcmp(&old, &kv.second, sizeof(Record)) == 0) continue;
+            superseded++;
+        }
+        changed.push_back(kv.second);
+    }
+    size_t live = mapped_index.size() - superseded + changed.size();
+    bool compact = mapped_records > 0 && stale + superseded >= live && stale + superseded >= MIN_COMPACT_RECORDS;
+    bool rewrite = compact || mapped_records == 0;
+    if (changed.empty() && !rewrite) return true;
+
+    if (rewrite) {
+        // Live mapped records not superseded in this run, then everything changed
+        std::string tmp = file_path + ".tmp";
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        writeHeader(out);
+        for (const auto& kv : mapped_index) {
+            auto f = fresh.find(kv.first);
+            Record r = mappedRecord(kv.second);
+            if (f != fresh.end() && std::memcmp(&r, &f->second, sizeof(Record)) != 0) continue;
+            out.write(reinterpret_cast<const char*>(&r), sizeof(Record));
+        }
+        out.write(reinterpret_cast<const char*>(changed.data()), (std::streamsize)(changed.size() * sizeof(Record)));
+        out.close();
+        if (!out) return false;
+        mapped.close();
+        // Replace in one step so a crash leaves either the old store or the new one
+        // (std::filesystem::rename overwrites an existing target on every platform)
+        std::error_code ec;
+        std::filesystem::rename(tmp, file_path, ec);
+        if (ec) return false;
+    } else {
+        std::ofstream out(file_path, std::ios::binary | std::ios::app);
+        if (!out.is_open()) return false;
+        out.write(reinterpret_cast<const char*>(changed.data()), (std::streamsize)(changed.size() * sizeof(Record)));
+        if (!out) return false;
+    }
+    // Re-map so further lookups see what was written and nothing is written twice
+    uint64_t hits = hit_count, misses = miss_count;
+    bool ok = open(file_path, version);
+    hit_count = hits;
+    miss_count = misses;
+    return ok;
+}
+
+uint64_t VerdictStore::nameKey(std::string_view id) {
+    std::string lower(id);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    return hashString64(lower);
+}
+
+uint64_t VerdictStore::contentKey(std::string_view content, PacketRange sequence) {
+    uint64_t h = hashString64(content);
+    for (const auto& packet : sequence) h = hashString64(packet, mix64(h));
+    return h;
+}
+
+} // namespace CS311
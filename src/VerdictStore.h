@@ -0,0 +1,93 @@
+/**
+ * VerdictStore.h
+ * On-disk, append-only store of per-record verdicts reused across pipeline runs
+ */
+
+#ifndef VERDICTSTORE_H
+#define VERDICTSTORE_H
+
+#include "Utils.h"
+#include "MappedFile.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * Maps (name hash, content hash) to the verdicts computed for that record: content DFA result
+ * with the matched-pattern bitmask, and the PDA accept/reject result with its final stack depth.
+ * Every record carries the pattern-set version it was computed under; records from another
+ * version are ignored at load time, so changing any pattern, list or grammar invalidates them.
+ *
+ * File layout: 16-byte header ("VSTO", format version, record size, reserved) followed by
+ * fixed 32-byte records. The existing file is mapped read-only at open(); new or updated
+ * records are kept in memory and appended by flush(), later records overriding earlier ones.
+ * When superseded and stale records outnumber live ones, flush() rewrites the file compacted.
+ *
+ * Not thread-safe: the pipeline stages that use it run on one thread.
+ */
+class VerdictStore {
+public:
+    enum Flags : uint16_t {
+        CONTENT_SCANNED   = 1 << 0,
+        CONTENT_MALICIOUS = 1 << 1,
+        PDA_EVALUATED     = 1 << 2,
+        PDA_ACCEPTED      = 1 << 3
+    };
+    struct Record {
+        uint64_t name_hash;
+        uint64_t content_hash;
+        uint64_t pattern_version;
+        uint32_t match_mask;     // bit i: content pattern i matched
+        uint16_t flags;
+        uint16_t stack_depth;    // PDA stack depth after the last packet
+    };
+    static_assert(sizeof(Record) == 32, "VerdictStore::Record must stay 32 bytes (on-disk format)");
+
+    // Maps `path` if it exists; a missing file starts an empty store. Returns false only for an
+    // unreadable or foreign file (the store then starts empty and flush() replaces the file).
+    bool open(const std::string& path, uint64_t patternVersion);
+    bool isOpen() const { return !file_path.empty(); }
+    // Record for this key under the current pattern-set version, or nullptr
+    const Record* find(uint64_t nameHash, uint64_t contentHash);
+    // Mutable record for this key (created empty if absent); written on the next flush()
+    Record& upsert(uint64_t nameHash, uint64_t contentHash);
+    // Append new/changed records (or rewrite compacted); returns false on I/O errors
+    bool flush();
+
+    // Key halves: case-insensitive record id, and payload plus packet sequence
+    static uint64_t nameKey(std::string_view id);
+    static uint64_t contentKey(std::string_view content, PacketRange sequence = PacketRange());
+
+    size_t loadedRecords() const { return mapped_index.size(); }
+    size_t staleRecords() const { return stale; }
+    uint64_t hits() const { return hit_count; }
+    uint64_t misses() const { return miss_count; }
+    size_t pendingRecords() const { return fresh.size(); }
+
+private:
+    struct Key {
+        uint64_t name, content;
+        bool operator==(const Key& o) const { return name == o.name && content == o.content; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const { return (size_t)mix64(k.name ^ ((k.content << 1) | (k.content >> 63))); }
+    };
+
+    std::string file_path;
+    uint64_t version = 0;
+    MappedFile mapped;
+    size_t mapped_records = 0;                          // records in the mapped file
+    std::unordered_map<Key, size_t, KeyHash> mapped_index; // key -> latest current-version record
+    std::unordered_map<Key, Record, KeyHash> fresh;     // created or changed during this run
+    size_t stale = 0;                                   // superseded or other-version records on disk
+    uint64_t hit_count = 0, miss_count = 0;
+
+    Record mappedRecord(size_t i) const;
+};
+
+} // namespace CS311
+
+#endif // VERDICTSTORE_H
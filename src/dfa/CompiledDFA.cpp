@@ -0,0 +1,235 @@
+/**
+ * CompiledDFA.cpp
+ * Dense byte-indexed transition tables and a resumable multi-DFA stream scanner
+ */
+
+#include "CompiledDFA.h"
+#include <map>
+#include <queue>
+#include <unordered_map>
+
+namespace CS311 {
+
+CompiledDFA CompiledDFA::fromDFA(const DFA& dfa, bool normalizeInput) {
+    CompiledDFA c;
+    // Dense renumbering of state ids; one extra dead state absorbs undefined transitions
+    std::map<int, uint32_t> index;
+    for (const auto& st : dfa.states) index.emplace(st.id, (uint32_t)index.size());
+    const uint32_t n = (uint32_t)index.size() + 1;
+    const uint32_t dead = n - 1;
+
+    // Byte -> symbol the per-pattern DFAs were run on (see DFAModule::runDFA)
+    char symbol[256];
+    for (int b = 0; b < 256; ++b) {
+        int ch = (b >= 'A' && b <= 'Z') ? b + ('a' - 'A') : b;
+        symbol[b] = !normalizeInput ? (char)b : (ch >= 32 && ch <= 126) ? (char)ch : '_';
+    }
+
+    c.table.assign((size_t)n * 256, dead);
+    c.accepting.assign(n, 0);
+    c.settled.assign(n, 0);
+    for (const auto& kv : index) {
+        uint32_t s = kv.second;
+        c.accepting[s] = dfa.accepting_states.count(kv.first) ? 1 : 0;
+        for (int b = 0; b < 256; ++b) {
+            int t = dfa.getNextState(kv.first, symbol[b]);
+            auto it = (t == -1) ? index.end() : index.find(t);
+            if (it != index.end()) c.table[((size_t)s << 8) | b] = it->second;
+        }
+    }
+    auto it = index.find(dfa.start_state);
+    c.start = (it != index.end()) ? it->second : dead;
+
+    // Backward reachability over the reversed graph: a state is settled when it cannot reach
+    // an accepting state (settled-reject) or cannot reach a rejecting one (settled-accept)
+    std::vector<std::vector<uint32_t>> preds(n);
+    for (uint32_t s = 0; s < n; ++s) {
+        for (int b = 0; b < 256; ++b) {
+            uint32_t t = c.table[((size_t)s << 8) | b];
+            if (preds[t].empty() || preds[t].back() != s) preds[t].push_back(s);
+        }
+    }
+    auto reachesWhere = [&](uint8_t wantAccepting) {
+        std::vector<uint8_t> seen(n, 0);
+        std::queue<uint32_t> work;
+        for (uint32_t s = 0; s < n; ++s) {
+            if (c.accepting[s] == wantAccepting) { seen[s] = 1; work.push(s); }
+        }
+        while (!work.empty()) {
+            uint32_t t = work.front();
+            work.pop();
+            for (uint32_t p : preds[t]) if (!seen[p]) { seen[p] = 1; work.push(p); }
+        }
+        return seen;
+    };
+    std::vector<uint8_t> canAccept = reachesWhere(1);
+    std::vector<uint8_t> canReject = reachesWhere(0);
+    for (uint32_t s = 0; s < n; ++s) c.settled[s] = (!canAccept[s] || !canReject[s]) ? 1 : 0;
+    return c;
+}
+
+uint32_t CompiledDFA::run(uint32_t s, const unsigned char* data, size_t n) const {
+    const uint32_t* t = table.data();
+    for (size_t i = 0; i < n; ++i) {
+        if (settled[s]) break;
+        s = t[((size_t)s << 8) | data[i]];
+    }
+    return s;
+}
+
+bool CompiledDFA::matches(const char* data, size_t n) const {
+    return isAccepting(run(start, reinterpret_cast<const unsigned char*>(data), n));
+}
+
+StreamScanner::StreamScanner(const std::vector<CompiledDFA>& d, const std::vector<std::string>& nm)
+    : dfas(&d), names(&nm) {
+    reset();
+}
+
+void StreamScanner::reset() {
+    states.resize(dfas->size());
+    for (size_t i = 0; i < dfas->size(); ++i) states[i] = (*dfas)[i].startState();
+    bytes = 0;
+    certain_match = false;
+    for (size_t i = 0; i < dfas->size(); ++i) {
+        const CompiledDFA& d = (*dfas)[i];
+        if (d.isSettled(states[i]) && d.isAccepting(states[i])) certain_match = true;
+    }
+}
+
+bool StreamScanner::feed(const char* data, size_t n) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    // DFA-major: each automaton walks the whole chunk with its table hot in cache
+    for (size_t i = 0; i < dfas->size(); ++i) {
+        const CompiledDFA& d = (*dfas)[i];
+        if (d.isSettled(states[i])) continue;
+        states[i] = d.run(states[i], p, n);
+        if (d.isSettled(states[i]) && d.isAccepting(states[i])) certain_match = true;
+    }
+    bytes += n;
+    return decided();
+}
+
+bool StreamScanner::decided() const {
+    if (certain_match) return true;
+    for (size_t i = 0; i < dfas->size(); ++i) {
+        if (!(*dfas)[i].isSettled(states[i])) return false;
+    }
+    return true;
+}
+
+bool StreamScanner::finish(std::string& matched_pattern) const {
+    for (size_t i = 0; i < dfas->size() && i < names->size(); ++i) {
+        if ((*dfas)[i].isAccepting(states[i])) {
+            matched_pattern = (*names)[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace {
+const uint32_t DROPPED = 0xFFFFFFFFu;  // component can no longer affect the answer
+const uint32_t NEVER = 0xFFFFFFFEu;    // component is settled-reject
+
+struct TupleHash {
+    size_t operator()(const std::vector<uint32_t>& t) const {
+        return (size_t)hashBytes64(t.data(), t.size() * sizeof(uint32_t));
+    }
+};
+} // namespace
+
+void MultiDFA::build(std::vector<CompiledDFA> comps, size_t maxStates) {
+    components = std::move(comps);
+    table.clear();
+    first_accepting.clear();
+    settled.clear();
+    product_built = false;
+    const size_t k = components.size();
+
+    std::unordered_map<std::vector<uint32_t>, uint32_t, TupleHash> ids;
+    std::vector<std::vector<uint32_t>> tuples;
+
+    auto canonical = [&](std::vector<uint32_t>& t) {
+        bool decided = false;
+        for (size_t i = 0; i < k; ++i) {
+            if (decided) { t[i] = DROPPED; continue; }
+            if (t[i] >= NEVER) continue;
+            const CompiledDFA& c = components[i];
+            if (!c.isSettled(t[i])) continue;
+            if (c.isAccepting(t[i])) decided = true; // lower indices may still match; higher cannot win
+            else t[i] = NEVER;
+        }
+    };
+    auto intern = [&](std::vector<uint32_t>& t) -> int64_t {
+        canonical(t);
+        auto it = ids.find(t);
+        if (it != ids.end()) return it->second;
+        if (tuples.size() >= maxStates) return -1;
+        uint32_t id = (uint32_t)tuples.size();
+        ids.emplace(t, id);
+        tuples.push_back(t);
+        return id;
+    };
+
+    std::vector<uint32_t> t(k);
+    for (size_t i = 0; i < k; ++i) t[i] = components[i].startState();
+    if (intern(t) < 0) return;
+    start = 0;
+
+    std::vector<uint32_t> next(k);
+    for (size_t s = 0; s < tuples.size(); ++s) {
+        table.resize((s + 1) * 256);
+        const std::vector<uint32_t> cur = tuples[s]; // copy: interning may grow `tuples`
+        for (int b = 0; b < 256; ++b) {
+            for (size_t i = 0; i < k; ++i) {
+                next[i] = (cur[i] >= NEVER) ? cur[i] : components[i].step(cur[i], (unsigned char)b);
+            }
+            int64_t id = intern(next);
+            if (id < 0) { table.clear(); return; } // too large: fall back to lockstep
+            table[s * 256 + b] = (uint32_t)id;
+        }
+    }
+
+    first_accepting.assign(tuples.size(), -1);
+    settled.assign(tuples.size(), 0);
+    for (size_t s = 0; s < tuples.size(); ++s) {
+        bool allSettled = true;
+        for (size_t i = 0; i < k; ++i) {
+            uint32_t q = tuples[s][i];
+            if (q >= NEVER) continue;
+            if (components[i].isAccepting(q) && first_accepting[s] == -1) first_accepting[s] = (int)i;
+            if (!components[i].isSettled(q)) allSettled = false;
+        }
+        settled[s] = allSettled ? 1 : 0;
+    }
+    product_built = true;
+}
+
+int MultiDFA::firstMatch(const char* data, size_t n) const {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    if (product_built) {
+        uint32_t s = start;
+        const uint32_t* t = table.data();
+        for (size_t i = 0; i < n && !settled[s]; ++i) s = t[((size_t)s << 8) | p[i]];
+        return first_accepting[s];
+    }
+    std::vector<size_t> all = allMatches(data, n);
+    return all.empty() ? -1 : (int)all.front();
+}
+
+std::vector<size_t> MultiDFA::allMatches(const char* data, size_t n) const {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    std::vector<uint32_t> states(components.size());
+    for (size_t i = 0; i < components.size(); ++i) states[i] = components[i].startState();
+    for (size_t j = 0; j < n; ++j) {
+        for (size_t i = 0; i < components.size(); ++i) states[i] = components[i].step(states[i], p[j]);
+    }
+    std::vector<size_t> matches;
+    for (size_t i = 0; i < components.size(); ++i) {
+        if (components[i].isAccepting(states[i])) matches.push_back(i);
+    }
+    return matches;
+}
+
+} // namespace CS311
@@ -0,0 +1,117 @@
+/**
+ * CompiledDFA.h
+ * Dense byte-indexed transition tables and a resumable multi-DFA stream scanner
+ */
+
+#ifndef COMPILEDDFA_H
+#define COMPILEDDFA_H
+
+#include "Utils.h"
+#include <string>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * A minimized DFA flattened into a states x 256 table over raw bytes. The input
+ * normalization of DFAModule::runDFA (ASCII lowercase, non-printable bytes -> '_') is folded
+ * into the table, so callers feed unmodified bytes without making a lowercased copy.
+ * Undefined transitions go to an explicit dead state. With normalizeInput = false the DFA's
+ * symbols are raw bytes (for automata defined over all 256 byte values, e.g. heuristics).
+ *
+ * States are classified once at compile time:
+ *   settled-accept: every continuation is accepted (e.g. after a substring match)
+ *   settled-reject: no continuation can be accepted
+ * Scanning a block stops as soon as a settled state is reached.
+ */
+class CompiledDFA {
+private:
+    std::vector<uint32_t> table;       // state * 256 + byte -> state
+    std::vector<uint8_t> accepting;
+    std::vector<uint8_t> settled;      // 1 = outcome fixed regardless of further input
+    uint32_t start = 0;
+
+public:
+    static CompiledDFA fromDFA(const DFA& dfa, bool normalizeInput = true);
+
+    uint32_t startState() const { return start; }
+    uint32_t step(uint32_t s, unsigned char b) const { return table[((size_t)s << 8) | b]; }
+    // Advance over a block; returns early once a settled state is reached
+    uint32_t run(uint32_t s, const unsigned char* data, size_t n) const;
+    bool isAccepting(uint32_t s) const { return accepting[s] != 0; }
+    bool isSettled(uint32_t s) const { return settled[s] != 0; }
+    // Whole-buffer membership (same verdict as DFAModule::runDFA on the same bytes)
+    bool matches(const char* data, size_t n) const;
+
+    size_t stateCount() const { return accepting.size(); }
+    size_t memoryBytes() const { return table.size() * sizeof(uint32_t) + accepting.size() + settled.size(); }
+};
+
+/**
+ * Runs a set of compiled DFAs over a byte stream delivered in arbitrary chunks, carrying each
+ * automaton's state across chunk boundaries, so memory use is independent of stream length.
+ * The verdict matches running the same DFAs over the concatenated stream: the match is the
+ * lowest-index pattern accepting at end of stream.
+ *
+ * decided() becomes true as soon as the verdict can no longer change: some DFA is in a
+ * settled-accept state (malicious) or every DFA is settled-reject (benign). A caller that
+ * stops early on a malicious decision gets the lowest-index pattern matched so far.
+ */
+class StreamScanner {
+private:
+    const std::vector<CompiledDFA>* dfas;
+    const std::vector<std::string>* names;
+    std::vector<uint32_t> states;
+    uint64_t bytes = 0;
+    bool certain_match = false;
+
+public:
+    StreamScanner(const std::vector<CompiledDFA>& dfas, const std::vector<std::string>& names);
+    void reset();
+    // Consume the next chunk; returns decided()
+    bool feed(const char* data, size_t n);
+    bool feed(const std::string& chunk) { return feed(chunk.data(), chunk.size()); }
+    bool decided() const;
+    // End-of-stream verdict; matched_pattern is set to the first accepting pattern's name
+    bool finish(std::string& matched_pattern) const;
+    uint64_t bytesConsumed() const { return bytes; }
+};
+
+/**
+ * Single-pass matcher for an ordered list of compiled DFAs (lower index = higher priority).
+ * The components are combined into one product table, so a filename costs one lookup per
+ * byte regardless of how many patterns there are. Product states only keep what can still
+ * change the answer "lowest-index component accepting at end of input": once component i is
+ * settled-accept, components after i are dropped from the tuple, and settled-reject components
+ * collapse to one marker, which keeps substring-pattern products small.
+ *
+ * If the product would exceed maxStates the components are run in lockstep instead (still one
+ * pass over the bytes, one lookup per component per byte).
+ */
+class MultiDFA {
+private:
+    std::vector<CompiledDFA> components;
+    std::vector<uint32_t> table;           // product state * 256 + byte -> product state
+    std::vector<int> first_accepting;      // per product state: lowest accepting component or -1
+    std::vector<uint8_t> settled;          // per product state: answer can no longer change
+    uint32_t start = 0;
+    bool product_built = false;
+
+public:
+    static constexpr size_t DEFAULT_MAX_STATES = 1 << 14;
+
+    void build(std::vector<CompiledDFA> comps, size_t maxStates = DEFAULT_MAX_STATES);
+    // Lowest-index component accepting `data`, or -1
+    int firstMatch(const char* data, size_t n) const;
+    // Every accepting component index, ascending (one pass, components in lockstep)
+    std::vector<size_t> allMatches(const char* data, size_t n) const;
+
+    size_t componentCount() const { return components.size(); }
+    bool hasProduct() const { return product_built; }
+    size_t stateCount() const { return first_accepting.size(); }
+    size_t memoryBytes() const { return table.size() * sizeof(uint32_t) + first_accepting.size() * sizeof(int); }
+};
+
+} // namespace CS311
+
+#endif // COMPILEDDFA_H
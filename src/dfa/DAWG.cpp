@@ -0,0 +1,164 @@
+/**
+ * DAWG.cpp
+ * Incremental construction of minimal acyclic DFAs from sorted word lists
+ */
+
+#include "DAWG.h"
+#include <algorithm>
+
+namespace CS311 {
+
+DAWG::DAWG() {
+    build_nodes.emplace_back(); // root
+}
+
+// Right-language signature: finality plus outgoing (label, registered target) pairs.
+// Children are always registered before their parent, so equal signatures mean equal languages.
+std::string DAWG::signature(int node) const {
+    const BuildNode& n = build_nodes[node];
+    std::string sig;
+    sig.reserve(1 + n.edges.size() * 5);
+    sig.push_back(n.is_final ? '1' : '0');
+    for (const auto& e : n.edges) {
+        sig.push_back((char)e.first);
+        sig.append(reinterpret_cast<const char*>(&e.second), sizeof(int));
+    }
+    return sig;
+}
+
+// Replace-or-register the unchecked path from the deepest state up to depth `downTo`
+void DAWG::minimize(size_t downTo) {
+    while (unchecked.size() > downTo) {
+        Unchecked u = unchecked.back();
+        unchecked.pop_back();
+        std::string sig = signature(u.child);
+        auto it = registry.find(sig);
+        if (it != registry.end()) {
+            // Equivalent state exists: redirect the parent's last edge and recycle the child
+            // (its own children are registered, so nothing else points at it)
+            build_nodes[u.parent].edges.back().second = it->second;
+            build_nodes[u.child].is_final = false;
+            build_nodes[u.child].edges.clear();
+            free_nodes.push_back(u.child);
+        } else {
+            registry.emplace(std::move(sig), u.child);
+        }
+    }
+}
+
+bool DAWG::add(const std::string& word) {
+    if (finished) return false;
+    if (word_count > 0 && word <= previous_word) return false;
+
+    size_t common = 0;
+    size_t limit = std::min(word.size(), previous_word.size());
+    while (common < limit && word[common] == previous_word[common]) common++;
+
+    minimize(common);
+
+    int node = unchecked.empty() ? 0 : unchecked.back().child;
+    for (size_t i = common; i < word.size(); ++i) {
+        int next;
+        if (!free_nodes.empty()) {
+            next = free_nodes.back();
+            free_nodes.pop_back();
+        } else {
+            next = (int)build_nodes.size();
+            build_nodes.emplace_back();
+        }
+        build_nodes[node].edges.push_back({(unsigned char)word[i], next});
+        unchecked.push_back({node, (unsigned char)word[i], next});
+        node = next;
+    }
+    build_nodes[node].is_final = true;
+    previous_word = word;
+    word_count++;
+    return true;
+}
+
+void DAWG::finish() {
+    if (finished) return;
+    minimize(0);
+    finished = true;
+
+    // Compact reachable states into flat arrays (BFS from the root, root = 0)
+    std::vector<int> remap(build_nodes.size(), -1);
+    std::vector<int> order = {0};
+    remap[0] = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (const auto& e : build_nodes[order[i]].edges) {
+            if (remap[e.second] == -1) {
+                remap[e.second] = (int)order.size();
+                order.push_back(e.second);
+            }
+        }
+    }
+
+    first_edge.assign(order.size() + 1, 0);
+    final_state.assign(order.size(), false);
+    for (size_t i = 0; i < order.size(); ++i) {
+        const BuildNode& n = build_nodes[order[i]];
+        first_edge[i] = (unsigned int)edge_label.size();
+        final_state[i] = n.is_final;
+        for (const auto& e : n.edges) {
+            edge_label.push_back(e.first);
+            edge_target.push_back((unsigned int)remap[e.second]);
+        }
+    }
+    first_edge[order.size()] = (unsigned int)edge_label.size();
+
+    // Release build-time structures
+    std::vector<BuildNode>().swap(build_nodes);
+    std::vector<Unchecked>().swap(unchecked);
+    std::vector<int>().swap(free_nodes);
+    std::unordered_map<std::string,int>().swap(registry);
+    std::string().swap(previous_word);
+}
+
+DAWG DAWG::fromWords(std::vector<std::string> words) {
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    DAWG d;
+    for (const auto& w : words) d.add(w);
+    d.finish();
+    return d;
+}
+
+int DAWG::step(int state, unsigned char c) const {
+    // Edges are sorted by label; states have few edges, so a linear scan beats binary search
+    for (unsigned int e = first_edge[state]; e < first_edge[state + 1]; ++e) {
+        if (edge_label[e] == c) return (int)edge_target[e];
+        if (edge_label[e] > c) break;
+    }
+    return -1;
+}
+
+bool DAWG::contains(const std::string& word) const {
+    if (final_state.empty()) return false;
+    int state = 0;
+    for (unsigned char c : word) {
+        state = step(state, c);
+        if (state == -1) return false;
+    }
+    return final_state[state];
+}
+
+bool DAWG::containsReversedSuffixOf(const std::string& text) const {
+    if (final_state.empty()) return false;
+    int state = 0;
+    for (size_t i = text.size(); i > 0; --i) {
+        state = step(state, (unsigned char)text[i - 1]);
+        if (state == -1) return false;
+        if (final_state[state]) return true;
+    }
+    return false;
+}
+
+size_t DAWG::memoryBytes() const {
+    return first_edge.size() * sizeof(unsigned int)
+         + edge_label.size() * sizeof(unsigned char)
+         + edge_target.size() * sizeof(unsigned int)
+         + final_state.size() / 8;
+}
+
+} // namespace CS311
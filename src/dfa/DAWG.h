@@ -0,0 +1,75 @@
+/**
+ * DAWG.h
+ * Minimal acyclic DFA (directed acyclic word graph) for large exact-match word lists
+ */
+
+#ifndef DAWG_H
+#define DAWG_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace CS311 {
+
+/**
+ * Incremental minimal acyclic DFA construction (Daciuk et al., sorted input).
+ * Words must be added in strictly increasing lexicographic order; after each word only
+ * the path of the previous word that diverges from the new one is minimized, so the
+ * automaton is minimal at all times. States replaced by a registered equivalent are recycled
+ * for the next word, so build memory stays proportional to the result plus one word's path.
+ *
+ * After finish() the automaton is compacted into flat arrays (edges sorted by label per
+ * state), so lookups are O(|word|) with a short scan per state.
+ */
+class DAWG {
+private:
+    // Build-time representation
+    struct BuildNode {
+        bool is_final = false;
+        std::vector<std::pair<unsigned char,int>> edges; // appended in increasing label order
+    };
+    struct Unchecked { int parent; unsigned char label; int child; };
+    std::vector<BuildNode> build_nodes;
+    std::vector<Unchecked> unchecked;
+    std::vector<int> free_nodes;                  // replaced states, reused by add()
+    std::unordered_map<std::string,int> registry; // state signature -> registered state
+    std::string previous_word;
+    bool finished = false;
+
+    // Compact representation (valid after finish())
+    std::vector<unsigned int> first_edge;   // per state: index of first edge; size = states + 1
+    std::vector<unsigned char> edge_label;
+    std::vector<unsigned int> edge_target;
+    std::vector<bool> final_state;
+    size_t word_count = 0;
+
+    std::string signature(int node) const;
+    void minimize(size_t downTo);
+    int step(int state, unsigned char c) const;
+
+public:
+    DAWG();
+    // Add the next word; returns false (and ignores it) if not strictly greater than the previous one
+    bool add(const std::string& word);
+    // Minimize the remaining path and compact into flat arrays
+    void finish();
+    // Build from an arbitrary word list (sorted and deduplicated internally)
+    static DAWG fromWords(std::vector<std::string> words);
+
+    // Exact membership: O(|word|)
+    bool contains(const std::string& word) const;
+    // Reverse-automaton helper: true if any suffix of `text` is in the set, when the set was built
+    // from reversed words. Walks `text` from its last character: O(|text|).
+    bool containsReversedSuffixOf(const std::string& text) const;
+
+    bool empty() const { return word_count == 0; }
+    size_t size() const { return word_count; }
+    size_t stateCount() const { return final_state.size(); }
+    size_t edgeCount() const { return edge_label.size(); }
+    size_t memoryBytes() const;
+};
+
+} // namespace CS311
+
+#endif // DAWG_H
@@ -0,0 +1,125 @@
+/**
+ * DFAAlgebra.cpp
+ * Product constructions (intersection, union, difference) and complement on DFAs
+ */
+
+#include "DFAAlgebra.h"
+#include <map>
+#include <queue>
+
+namespace CS311 {
+
+DFA DFAAlgebra::product(const DFA& a, const DFA& b, Op op, const std::set<char>& alphabet) {
+    DFA result;
+    // Product state (p, q); -1 stands for the implicit sink of a partial DFA
+    std::map<std::pair<int,int>, int> state_map;
+    std::queue<std::pair<int,int>> worklist;
+
+    auto accepting = [&](int p, int q) {
+        bool inA = p != -1 && a.accepting_states.count(p) > 0;
+        bool inB = q != -1 && b.accepting_states.count(q) > 0;
+        switch (op) {
+            case Op::Intersection: return inA && inB;
+            case Op::Union:        return inA || inB;
+            case Op::Difference:   return inA && !inB;
+        }
+        return false;
+    };
+    auto getOrAdd = [&](int p, int q) {
+        auto it = state_map.find({p, q});
+        if (it != state_map.end()) return it->second;
+        int id = (int)result.states.size();
+        bool acc = accepting(p, q);
+        result.addState(State(id, acc));
+        if (acc) result.accepting_states.insert(id);
+        state_map[{p, q}] = id;
+        worklist.push({p, q});
+        return id;
+    };
+
+    result.start_state = getOrAdd(a.start_state, b.start_state);
+    while (!worklist.empty()) {
+        auto [p, q] = worklist.front();
+        worklist.pop();
+        int from = state_map[{p, q}];
+        for (char c : alphabet) {
+            int np = (p == -1) ? -1 : a.getNextState(p, c);
+            int nq = (q == -1) ? -1 : b.getNextState(q, c);
+            result.addTransition(from, c, getOrAdd(np, nq));
+        }
+    }
+    result.alphabet = alphabet;
+    return result;
+}
+
+DFA DFAAlgebra::intersect(const DFA& a, const DFA& b, const std::set<char>& alphabet) {
+    return product(a, b, Op::Intersection, alphabet);
+}
+
+DFA DFAAlgebra::unite(const DFA& a, const DFA& b, const std::set<char>& alphabet) {
+    return product(a, b, Op::Union, alphabet);
+}
+
+DFA DFAAlgebra::difference(const DFA& a, const DFA& b, const std::set<char>& alphabet) {
+    return product(a, b, Op::Difference, alphabet);
+}
+
+DFA DFAAlgebra::complement(const DFA& a, const std::set<char>& alphabet) {
+    // Σ* \ L(a) is the difference with the one-state universal automaton
+    DFA universal;
+    universal.addState(State(0, true));
+    universal.accepting_states.insert(0);
+    for (char c : alphabet) universal.addTransition(0, c, 0);
+    return product(universal, a, Op::Difference, alphabet);
+}
+
+bool DFAAlgebra::isEmpty(const DFA& a) {
+    if (a.states.empty()) return true;
+    std::set<int> seen = {a.start_state};
+    std::queue<int> worklist;
+    worklist.push(a.start_state);
+    while (!worklist.empty()) {
+        int s = worklist.front();
+        worklist.pop();
+        if (a.accepting_states.count(s)) return false;
+        for (char c : a.alphabet) {
+            int t = a.getNextState(s, c);
+            if (t != -1 && seen.insert(t).second) worklist.push(t);
+        }
+    }
+    return true;
+}
+
+// L(a) ⊆ L(b) iff no reachable product state (p, q) has p accepting in a and q rejecting in b
+bool DFAAlgebra::isSubsetOf(const DFA& a, const DFA& b) {
+    std::set<char> Sigma = a.alphabet;
+    Sigma.insert(b.alphabet.begin(), b.alphabet.end());
+
+    std::set<std::pair<int,int>> seen;
+    std::queue<std::pair<int,int>> worklist;
+    worklist.push({a.start_state, b.start_state});
+    seen.insert({a.start_state, b.start_state});
+
+    while (!worklist.empty()) {
+        auto [p, q] = worklist.front();
+        worklist.pop();
+        bool aAccepts = a.accepting_states.count(p) > 0;
+        bool bAccepts = q != -1 && b.accepting_states.count(q) > 0;
+        if (aAccepts && !bAccepts) return false; // witness word in L(a) \ L(b)
+        for (char c : Sigma) {
+            int np = a.getNextState(p, c);
+            if (np == -1) continue; // a is dead: nothing below can be accepted by a
+            int nq = (q == -1) ? -1 : b.getNextState(q, c);
+            if (seen.insert({np, nq}).second) worklist.push({np, nq});
+        }
+    }
+    return true;
+}
+
+std::set<char> DFAAlgebra::printableAlphabet() {
+    std::set<char> Sigma;
+    for (char c = 32; c < 127; c++) Sigma.insert(c);
+    return Sigma;
+}
+
+} // namespace CS311
@@ -0,0 +1,49 @@
+/**
+ * DFAAlgebra.h
+ * Boolean operations on DFAs via reachable-only product construction
+ */
+
+#ifndef DFAALGEBRA_H
+#define DFAALGEBRA_H
+
+#include "Utils.h"
+#include <set>
+
+namespace CS311 {
+
+class DFAAlgebra {
+public:
+    enum class Op { Intersection, Union, Difference };
+
+    /**
+     * Product construction over an explicit alphabet.
+     * Only pairs reachable from (start_a, start_b) are materialized; missing transitions
+     * go to an implicit sink, so the result is complete over `alphabet`.
+     *   Intersection: L(a) ∩ L(b)
+     *   Union:        L(a) ∪ L(b)
+     *   Difference:   L(a) \ L(b)
+     * The result is not minimized (see DFAModule::hopcroftMinimize).
+     */
+    static DFA product(const DFA& a, const DFA& b, Op op, const std::set<char>& alphabet);
+    static DFA intersect(const DFA& a, const DFA& b, const std::set<char>& alphabet);
+    static DFA unite(const DFA& a, const DFA& b, const std::set<char>& alphabet);
+    static DFA difference(const DFA& a, const DFA& b, const std::set<char>& alphabet);
+
+    /**
+     * Complement over an explicit alphabet: Σ* \ L(a).
+     * The DFA is completed with a sink state before accepting states are flipped.
+     */
+    static DFA complement(const DFA& a, const std::set<char>& alphabet);
+
+    // Language emptiness (no accepting state reachable from start)
+    static bool isEmpty(const DFA& a);
+    // Language inclusion L(a) ⊆ L(b), checked on the fly without building L(a) \ L(b)
+    static bool isSubsetOf(const DFA& a, const DFA& b);
+
+    // Printable ASCII (32-126): the per-character tokenization alphabet used by the DFA module
+    static std::set<char> printableAlphabet();
+};
+
+} // namespace CS311
+
+#endif // DFAALGEBRA_H
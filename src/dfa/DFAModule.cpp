@@ -4,6 +4,9 @@
  */
 
 #include "DFAModule.h"
+#include "DirectoryWalker.h"
+#include "MappedFile.h"
+#include "CSVReader.h"
 #include <iostream>
 #include <fstream>
 #include <chrono>
@@ -15,11 +18,113 @@
 #include <sstream>
 #include <random>
 #include <iomanip>
+#include <mutex>
+#include <atomic>
 // (no extra headers needed for original implementation)
 
 namespace CS311 {
 
-DFAModule::DFAModule() {}
+DFAModule::DFAModule() : datasets(std::make_shared<DatasetStore>()) {
+    buildHeuristicDFAs();
+    compileFilenameMatcher();
+}
+
+// The hand-written filename checks expressed as DFAs over raw bytes (all 256 symbols, no
+// lowercasing), so they can share the product matcher with the regex patterns
+void DFAModule::buildHeuristicDFAs() {
+    heuristic_dfas.clear();
+    heuristic_names = { "unicode_trick", "double_extension", "whitespace_padding" };
+    auto makeDFA = [](int states, int accept, auto next) {
+        DFA d;
+        for (int s = 0; s < states; ++s) {
+            d.addState(State(s, s == accept));
+            if (s == accept) d.accepting_states.insert(s);
+        }
+        d.start_state = 0;
+        for (int s = 0; s < states; ++s) {
+            for (int b = 0; b < 256; ++b) d.addTransition(s, (char)b, next(s, (unsigned char)b));
+        }
+        return d;
+    };
+    // unicode_trick: some byte outside 7-bit ASCII
+    heuristic_dfas.push_back(makeDFA(2, 1, [](int s, unsigned char b) { return (s == 1 || b > 127) ? 1 : 0; }));
+    // double_extension: at least two '.'
+    heuristic_dfas.push_back(makeDFA(3, 2, [](int s, unsigned char b) { return b == '.' ? std::min(s + 1, 2) : s; }));
+    // whitespace_padding: two consecutive spaces
+    heuristic_dfas.push_back(makeDFA(3, 2, [](int s, unsigned char b) { return s == 2 ? 2 : (b == ' ' ? s + 1 : 0); }));
+
+    heuristic_compiled.clear();
+    for (const auto& d : heuristic_dfas) heuristic_compiled.push_back(CompiledDFA::fromDFA(d, false));
+}
+
+void DFAModule::compileFilenameMatcher() {
+    // Only the hot patterns run on every filename; component k < matcher_patterns is hot_patterns[k]
+    std::vector<CompiledDFA> comps;
+    size_t n = std::min(minimized_dfas.size(), pattern_names.size());
+    for (size_t i : hot_patterns) {
+        if (i < n) comps.push_back(CompiledDFA::fromDFA(minimized_dfas[i]));
+    }
+    matcher_patterns = comps.size();
+    for (const auto& h : heuristic_compiled) comps.push_back(h);
+    redundant_compiled.clear();
+    for (size_t r : redundant_patterns) redundant_compiled.push_back(CompiledDFA::fromDFA(minimized_dfas[r]));
+    filename_matcher.build(std::move(comps));
+    computeExtensionVerdicts();
+    filename_version++;
+}
+
+// For each known risky extension, find the first pattern i with Σ*·".ext" ⊆ L(i) over the
+// printable alphabet the pattern DFAs run on. Such an extension decides "suspicious" by itself.
+// Benign extensions never qualify: the patterns match substrings anywhere in the name.
+void DFAModule::computeExtensionVerdicts() {
+    extension_decides.assign(ExtensionTable::SLOTS, -1);
+    size_t n = std::min(minimized_dfas.size(), pattern_names.size());
+    if (n == 0) return;
+    std::set<char> Sigma = DFAAlgebra::printableAlphabet();
+    for (size_t slot = 0; slot < ExtensionTable::SLOTS; ++slot) {
+        if (ExtensionTable::classOf((int)slot) != ExtClass::Risky) continue;
+        // KMP automaton for Σ*·".ext": state k = longest prefix of the suffix read so far
+        std::string suffix = std::string(".") + ExtensionTable::extension((int)slot);
+        int m = (int)suffix.size();
+        DFA d;
+        for (int q = 0; q <= m; ++q) {
+            d.addState(State(q, q == m));
+            if (q == m) d.accepting_states.insert(q);
+        }
+        d.start_state = 0;
+        for (int q = 0; q <= m; ++q) {
+            for (char c : Sigma) {
+                std::string seen = suffix.substr(0, q) + c;
+                int k = std::min((int)seen.size(), m);
+                while (k > 0 && seen.compare(seen.size() - k, k, suffix, 0, k) != 0) --k;
+                d.addTransition(q, c, k);
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (DFAAlgebra::isSubsetOf(d, minimized_dfas[i])) { extension_decides[slot] = (int)i; break; }
+        }
+    }
+}
+
+ThreadPool* DFAModule::getPool() {
+    if (!pool || (int)pool->size() != num_threads) pool = std::make_unique<ThreadPool>((size_t)num_threads);
+    return pool.get();
+}
+
+template <typename Acc, typename Fn>
+void DFAModule::forEachDatasetChunk(std::vector<Acc>& partial, Fn fn) {
+    if (num_threads <= 1 || dataset.size() < 2) {
+        partial.assign(1, Acc{});
+        fn(partial[0], (size_t)0, dataset.size());
+        return;
+    }
+    // ~8 chunks per thread keeps stealing effective without shrinking chunks below a useful size
+    size_t grain = std::max<size_t>(256, dataset.size() / ((size_t)num_threads * 8) + 1);
+    partial.assign((dataset.size() + grain - 1) / grain, Acc{});
+    getPool()->parallelFor(dataset.size(), grain, [&](size_t c, size_t begin, size_t end) {
+        fn(partial[c], begin, end);
+    });
+}
 
 void DFAModule::clearDataset() {
     dataset.clear();
@@ -31,16 +136,23 @@ void DFAModule::loadDataset(const std::string& filepath) {
     metrics.filenames_tested = (int)dataset.size();
     // Dataset sanity checks: benign/malicious counts and extension frequency
     int malicious = 0, benign = 0;
+    // Known extensions are counted by perfect-hash slot; only unknown ones allocate a map key
     std::map<std::string,int> extFreq;
+    int knownFreq[ExtensionTable::SLOTS] = {};
     for (const auto& e : dataset) {
         if (e.is_malicious) malicious++; else benign++;
-        auto pos = e.filename.find_last_of('.');
-        if (pos != std::string::npos && pos+1 < e.filename.size()) {
-            std::string ext = e.filename.substr(pos+1);
+        const char* p; size_t n;
+        if (ExtensionTable::lastExtension(e.filename, p, n)) {
+            int slot = ExtensionTable::find(p, n);
+            if (slot >= 0) { knownFreq[slot]++; continue; }
+            std::string ext(p, n);
             std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
             extFreq[ext]++;
         }
     }
+    for (size_t slot = 0; slot < ExtensionTable::SLOTS; ++slot) {
+        if (knownFreq[slot] > 0) extFreq[ExtensionTable::extension((int)slot)] += knownFreq[slot];
+    }
     std::cout << "[INFO] Loading filename dataset: " << filepath << std::endl;
     std::cout << "[SUCCESS] Loaded " << dataset.size() << " filename entries" << std::endl;
     std::cout << "  Malicious: " << malicious << ", Benign: " << benign << std::endl;
@@ -61,16 +173,16 @@ void DFAModule::loadDataset(const std::string& filepath) {
 // Stage filenames from TCP tricks JSONL (trace_id used as filename)
 void DFAModule::loadFilenamesFromTCPJsonl(const std::string& filepath) {
     dataset.clear();
-    std::vector<TCPTrace> traces = JSONParser::loadTCPDataset(filepath);
+    DatasetStore::Views traces = datasets->views(filepath);
     int malicious = 0, benign = 0;
-    for (const auto& t : traces) {
+    for (const auto& t : traces->records()) {
         FilenameEntry e;
-        e.filename = t.trace_id;
+        e.filename.assign(t.trace_id);
         e.technique = "tcp_tricks";
-        e.category = t.category;
+        e.category.assign(t.category);
         e.detected_by = "tcp_jsonl";
         // Treat categories containing "Malicious" as malicious
-        std::string cat = t.category; std::transform(cat.begin(), cat.end(), cat.begin(), ::tolower);
+        std::string cat(t.category); std::transform(cat.begin(), cat.end(), cat.begin(), ::tolower);
         e.is_malicious = (cat.find("malicious") != std::string::npos);
         if (e.is_malicious) malicious++; else benign++;
         dataset.push_back(std::move(e));
@@ -84,15 +196,15 @@ void DFAModule::loadFilenamesFromTCPJsonl(const std::string& filepath) {
 // Stage filenames from combined_with_tcp.csv (trace_id used as filename)
 void DFAModule::loadFilenamesFromCSVTraces(const std::string& filepath) {
     dataset.clear();
-    std::vector<TCPTrace> traces = JSONParser::loadTCPDatasetCSV(filepath);
+    DatasetStore::Views traces = datasets->views(filepath);
     int malicious = 0, benign = 0;
-    for (const auto& t : traces) {
+    for (const auto& t : traces->records()) {
         FilenameEntry e;
-        e.filename = t.trace_id;
+        e.filename.assign(t.trace_id);
         e.technique = "csv_traces";
-        e.category = t.category;
+        e.category.assign(t.category);
         e.detected_by = "tcp_csv";
-        std::string cat = t.category; std::transform(cat.begin(), cat.end(), cat.begin(), ::tolower);
+        std::string cat(t.category); std::transform(cat.begin(), cat.end(), cat.begin(), ::tolower);
         e.is_malicious = (cat.find("malicious") != std::string::npos);
         if (e.is_malicious) malicious++; else benign++;
         dataset.push_back(std::move(e));
@@ -103,23 +215,127 @@ void DFAModule::loadFilenamesFromCSVTraces(const std::string& filepath) {
     std::cout << "  Malicious: " << malicious << ", Benign: " << benign << std::endl;
 }
 
-std::vector<std::string> DFAModule::classifyDatasetAndReturnDetected() {
-    std::vector<std::string> detected;
-    detected.reserve(dataset.size());
+// Blocklists of known-bad names are compiled into minimal acyclic DFAs instead of one
+// substring DFA per entry: exact names go into a forward DAWG, "*suffix" entries into a DAWG
+// over reversed suffixes so a filename is checked by walking it backwards once.
+void DFAModule::loadBlocklist(const std::string& filepath) {
+    std::ifstream in(filepath);
+    if (!in.is_open()) {
+        std::cerr << "[ERROR] Could not open blocklist: " << filepath << std::endl;
+        return;
+    }
+    std::cout << "[INFO] Loading blocklist: " << filepath << std::endl;
     auto start_time = std::chrono::high_resolution_clock::now();
-    int tp = 0, fp = 0, fn = 0; // aggregate simple stats relative to dataset label
-    for (const auto& entry : dataset) {
-        std::string matched;
-        bool isSuspicious = testFilenameWithDFA(entry.filename, matched);
-        if (isSuspicious) {
-            detected.push_back(entry.filename);
+
+    std::vector<std::string> exact, suffixes;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        std::transform(line.begin(), line.end(), line.begin(), ::tolower);
+        list_digest = hashString64(line, mix64(list_digest));
+        if (line[0] == '*') {
+            std::string suf = line.substr(1);
+            if (suf.empty()) continue;
+            std::reverse(suf.begin(), suf.end());
+            suffixes.push_back(std::move(suf));
+        } else {
+            exact.push_back(line);
         }
-        if (entry.is_malicious) {
-            if (isSuspicious) tp++; else fn++;
+    }
+    in.close();
+
+    blocklist_exact = DAWG::fromWords(std::move(exact));
+    blocklist_suffix = DAWG::fromWords(std::move(suffixes));
+    filename_version++;
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    std::cout << "[SUCCESS] Blocklist compiled (Daciuk incremental minimal acyclic DFA)" << std::endl;
+    std::cout << "  Exact names:   " << blocklist_exact.size() << " → " << blocklist_exact.stateCount()
+              << " states, " << blocklist_exact.edgeCount() << " edges" << std::endl;
+    std::cout << "  Suffixes:      " << blocklist_suffix.size() << " → " << blocklist_suffix.stateCount()
+              << " states, " << blocklist_suffix.edgeCount() << " edges" << std::endl;
+    std::cout << "  Memory:        " << (blocklist_exact.memoryBytes() + blocklist_suffix.memoryBytes()) / 1024 << " KB" << std::endl;
+    std::cout << "  Build time:    " << dur.count() << " ms" << std::endl;
+}
+
+// Known IOCs are checked with a split-block Bloom filter (one cache line per probe) backed by
+// sorted 64-bit fingerprints, so tens of millions of hashes cost ~12 bits + 8 bytes each and
+// no DFA has to be built for them.
+void DFAModule::loadIOCFilter(const std::string& path) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    bool fromCsv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    if (fromCsv) {
+        std::cout << "[INFO] Building IOC filter from: " << path << std::endl;
+        if (!ioc_filter.buildFromCSVs({path})) return;
+        std::string binPath = "output/ioc_filter.bin";
+        if (ioc_filter.save(binPath)) {
+            std::cout << "  Serialized to: " << binPath << std::endl;
         } else {
-            if (isSuspicious) fp++;
+            std::cerr << "[WARN] Could not write IOC filter: " << binPath << std::endl;
+        }
+    } else {
+        std::cout << "[INFO] Loading IOC filter: " << path << std::endl;
+        if (!ioc_filter.load(path)) {
+            std::cerr << "[ERROR] Could not read IOC filter: " << path
+                      << " (known-IOC stage disabled; rebuild it from the IOC CSV)" << std::endl;
+            return;
+        }
+    }
+    filename_version++;
+    list_digest = mix64(list_digest ^ ioc_filter.digest());
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto dur = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    std::cout << "[SUCCESS] IOC filter ready (split-block Bloom + exact fingerprints)" << std::endl;
+    std::cout << "  Keys:          " << ioc_filter.size() << std::endl;
+    std::cout << "  Memory:        " << ioc_filter.memoryBytes() / 1024 << " KB" << std::endl;
+    std::cout << "  Build time:    " << dur.count() << " ms" << std::endl;
+}
+
+bool DFAModule::matchKnownIOC(const std::string& lower) const {
+    if (ioc_filter.empty()) return false;
+    if (ioc_filter.contains(lower)) return true;
+    size_t dot = lower.find('.');
+    return dot != std::string::npos && dot > 0 && ioc_filter.contains(lower.substr(0, dot));
+}
+
+std::vector<std::string> DFAModule::classifyDatasetAndReturnDetected() {
+    // Per-chunk accumulators: the matchers are read-only here, so chunks run independently
+    struct ChunkResult { std::vector<std::string> detected; int tp = 0, fp = 0, fn = 0, fast = 0; };
+    std::vector<ChunkResult> partial;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    forEachDatasetChunk(partial, [&](ChunkResult& r, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto& entry = dataset[i];
+            // Verdict only: attribution is not needed here, so a deciding extension skips the automata
+            bool isSuspicious = decidingExtension(entry.filename) >= 0;
+            if (isSuspicious) {
+                r.fast++;
+            } else {
+                std::string matched;
+                isSuspicious = testFilenameWithDFA(entry.filename, matched);
+            }
+            if (isSuspicious) {
+                r.detected.push_back(entry.filename);
+            }
+            if (entry.is_malicious) {
+                if (isSuspicious) r.tp++; else r.fn++;
+            } else {
+                if (isSuspicious) r.fp++;
+            }
         }
+    });
+    // Deterministic merge in chunk order
+    std::vector<std::string> detected;
+    detected.reserve(dataset.size());
+    int tp = 0, fp = 0, fn = 0, fast = 0; // aggregate simple stats relative to dataset label
+    for (ChunkResult& r : partial) {
+        detected.insert(detected.end(), std::make_move_iterator(r.detected.begin()),
+                        std::make_move_iterator(r.detected.end()));
+        tp += r.tp; fp += r.fp; fn += r.fn; fast += r.fast;
     }
+    metrics.extension_fast_path = fast;
     auto end_time = std::chrono::high_resolution_clock::now();
     auto dur_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
     metrics.true_positives = tp;
@@ -176,20 +392,7 @@ void DFAModule::definePatterns() {
     regex_patterns.push_back("patch");
     pattern_names.push_back("deceptive_patch");
     
-    // Optionally collapse into a single combined alternation to produce one DFA
-    if (combineAll) {
-        if (!regex_patterns.empty()) {
-            std::ostringstream alt;
-            alt << "(";
-            for (size_t i = 0; i < regex_patterns.size(); ++i) {
-                if (i) alt << "|";
-                alt << regex_patterns[i];
-            }
-            alt << ")";
-            regex_patterns = { alt.str() };
-            pattern_names = { "combined_patterns" };
-        }
-    }
+    // Combined mode keeps one DFA per pattern until minimizeDFAs() folds them with a union product
 
     metrics.total_patterns = (int)regex_patterns.size();
 
@@ -265,13 +468,16 @@ void DFAModule::convertContentToDFAs() {
 void DFAModule::minimizeContentDFAs() {
     std::cout << "[INFO] Minimizing content DFAs (Hopcroft)..." << std::endl;
     content_minimized_dfas.clear();
+    content_compiled.clear();
     for (size_t i = 0; i < content_dfas.size(); ++i) {
         int steps = 0; std::vector<std::set<int>> parts;
         DFA M = hopcroftMinimize(content_dfas[i], steps, parts);
         content_minimized_dfas.push_back(M);
+        content_compiled.push_back(CompiledDFA::fromDFA(M));
         std::cout << "  Content DFA " << (i+1) << ": refinement steps = " << steps
                   << ", final equivalence classes = " << parts.size() << std::endl;
     }
+    content_version++;
     std::cout << "[SUCCESS] Minimized content DFAs" << std::endl;
 }
 
@@ -472,6 +678,48 @@ void DFAModule::minimizeDFAs() {
                   << ", final equivalence classes = " << finalPartitions.size() << std::endl;
     }
     
+    // Benign allowlist: each pattern becomes (pattern \ allowlist), compiled into the same single DFA
+    if (!allowlist_patterns.empty() && !minimized_dfas.empty()) {
+        DFA allow = compilePolicy(allowlist_patterns, {});
+        std::set<char> Sigma = DFAAlgebra::printableAlphabet();
+        for (auto& m : minimized_dfas) {
+            int steps = 0; std::vector<std::set<int>> parts;
+            m = hopcroftMinimize(DFAAlgebra::difference(m, allow, Sigma), steps, parts);
+        }
+        std::cout << "  Applied allowlist (" << allowlist_patterns.size() << " patterns) via product difference" << std::endl;
+    }
+
+    // Combined mode: fold all pattern DFAs into one via union products, minimizing as we go
+    if (combineAll && minimized_dfas.size() > 1) {
+        std::set<char> Sigma = DFAAlgebra::printableAlphabet();
+        DFA combined = minimized_dfas[0];
+        for (size_t i = 1; i < minimized_dfas.size(); ++i) {
+            int steps = 0; std::vector<std::set<int>> parts;
+            combined = hopcroftMinimize(DFAAlgebra::unite(combined, minimized_dfas[i], Sigma), steps, parts);
+        }
+        std::ostringstream alt;
+        alt << "(";
+        for (size_t i = 0; i < regex_patterns.size(); ++i) {
+            if (i) alt << "|";
+            alt << regex_patterns[i];
+        }
+        alt << ")";
+        minimized_dfas = { combined };
+        regex_patterns = { alt.str() };
+        pattern_names = { "combined_patterns" };
+        std::cout << "  Combined " << metrics.total_patterns << " pattern DFAs into one (union product): "
+                  << combined.getStateCount() << " states" << std::endl;
+    }
+    metrics.total_dfa_states_after_min = 0;
+    for (const auto& m : minimized_dfas) metrics.total_dfa_states_after_min += m.getStateCount();
+
+    // Until eliminateRedundantPatterns() runs, every pattern is in the hot match set
+    hot_patterns.clear();
+    for (size_t i = 0; i < minimized_dfas.size(); ++i) hot_patterns.push_back(i);
+    redundant_patterns.clear();
+    subsumed_by.assign(minimized_dfas.size(), -1);
+    metrics.redundant_patterns = 0;
+    
     auto end_time = std::chrono::high_resolution_clock::now();
     auto total_dur = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
     
@@ -481,6 +729,8 @@ void DFAModule::minimizeDFAs() {
              metrics.total_dfa_states_before_min) * 100.0;
     }
 
+    compileFilenameMatcher();
+
     std::cout << "[SUCCESS] Minimized DFAs (Hopcroft)" << std::endl;
     std::cout << "  States after minimization: " << metrics.total_dfa_states_after_min << std::endl;
     std::cout << "  Reduction: " << metrics.state_reduction_min_percent << "%" << std::endl;
@@ -488,6 +738,105 @@ void DFAModule::minimizeDFAs() {
     std::cout << "  Complexity: O(k n log n) where k = |alphabet|, n = |DFA states|" << std::endl;
     std::cout << "  Empirical: " << metrics.total_dfa_states_before_min << " states → " 
              << metrics.total_dfa_states_after_min << " states" << std::endl;
+    if (filename_matcher.hasProduct()) {
+        std::cout << "  Single-pass matcher: " << filename_matcher.componentCount() << " automata (patterns + heuristics) → "
+                  << filename_matcher.stateCount() << " product states, "
+                  << filename_matcher.memoryBytes() / 1024 << " KB" << std::endl;
+    } else {
+        std::cout << "  Single-pass matcher: product too large, running " << filename_matcher.componentCount()
+                  << " automata in lockstep" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+DFA DFAModule::buildMinimizedDFA(const std::string& regex) {
+    NFA nfa = RegexParser::regexToNFA(regex);
+    int steps = 0; std::vector<std::set<int>> parts;
+    return hopcroftMinimize(subsetConstruction(nfa), steps, parts);
+}
+
+// Compile a composite policy into a single DFA: matches any of `anyOf` and none of `noneOf`.
+// Every step is a reachable-only product followed by Hopcroft minimization, so intermediate
+// automata stay small and the final DFA runs in one pass over the input.
+DFA DFAModule::compilePolicy(const std::vector<std::string>& anyOf, const std::vector<std::string>& noneOf) {
+    std::set<char> Sigma = DFAAlgebra::printableAlphabet();
+    auto foldUnion = [&](const std::vector<std::string>& patterns) {
+        DFA acc;
+        bool first = true;
+        for (const auto& p : patterns) {
+            DFA d = buildMinimizedDFA(p);
+            if (first) { acc = d; first = false; continue; }
+            int steps = 0; std::vector<std::set<int>> parts;
+            acc = hopcroftMinimize(DFAAlgebra::unite(acc, d, Sigma), steps, parts);
+        }
+        return acc;
+    };
+
+    DFA include;
+    if (anyOf.empty()) {
+        // No include list means "everything": Σ* as the complement of the empty language
+        DFA empty;
+        empty.addState(State(0, false));
+        include = DFAAlgebra::complement(empty, Sigma);
+    } else {
+        include = foldUnion(anyOf);
+    }
+    if (noneOf.empty()) return include;
+
+    DFA exclude = foldUnion(noneOf);
+    int steps = 0; std::vector<std::set<int>> parts;
+    return hopcroftMinimize(DFAAlgebra::difference(include, exclude, Sigma), steps, parts);
+}
+
+// Compile-time redundancy elimination over the minimized filename DFAs.
+// Pattern i is redundant when its language is contained in another kept pattern's language
+// (for exact duplicates the earlier pattern is kept). The union of the hot languages equals the
+// union of all languages, so the verdict of testFilenameWithDFA is unchanged; redundant patterns
+// are still reported by testFilenameMatchesAll and used to keep first-match attribution exact.
+void DFAModule::eliminateRedundantPatterns() {
+    std::cout << "[INFO] Checking pattern subsumption (product-automaton inclusion)..." << std::endl;
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    size_t n = std::min(minimized_dfas.size(), pattern_names.size());
+    std::vector<bool> dropped(n, false);
+    subsumed_by.assign(minimized_dfas.size(), -1);
+    int checks = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (i == j || dropped[j]) continue;
+            checks++;
+            if (!DFAAlgebra::isSubsetOf(minimized_dfas[i], minimized_dfas[j])) continue;
+            // Equal languages: keep the earlier pattern, drop the later duplicate
+            if (j > i) {
+                checks++;
+                if (DFAAlgebra::isSubsetOf(minimized_dfas[j], minimized_dfas[i])) continue;
+            }
+            dropped[i] = true;
+            subsumed_by[i] = (int)j;
+            break;
+        }
+    }
+
+    hot_patterns.clear();
+    redundant_patterns.clear();
+    for (size_t i = 0; i < minimized_dfas.size(); ++i) {
+        if (i < n && dropped[i]) redundant_patterns.push_back(i);
+        else hot_patterns.push_back(i);
+    }
+    metrics.redundant_patterns = (int)redundant_patterns.size();
+    compileFilenameMatcher();
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto total_dur = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+
+    for (size_t r : redundant_patterns) {
+        std::cout << "  Pattern " << (r+1) << " (" << pattern_names[r] << ") is implied by pattern "
+                  << (subsumed_by[r]+1) << " (" << pattern_names[subsumed_by[r]] << ") - dropped from hot set" << std::endl;
+    }
+    std::cout << "[SUCCESS] Hot match set: " << hot_patterns.size() << " of " << minimized_dfas.size()
+              << " DFAs (" << redundant_patterns.size() << " redundant)" << std::endl;
+    std::cout << "  Inclusion checks: " << checks << " (time: " << total_dur.count() << " μs)" << std::endl;
     std::cout << std::endl;
 }
 
@@ -499,32 +848,54 @@ void DFAModule::testPatterns() {
     // Store sample TP and FN cases for reporting
     std::vector<std::string> sample_tp;
     std::vector<std::string> sample_fn;
-    const int MAX_SAMPLES = 5;
+    const size_t MAX_SAMPLES = 5;
     
-    for (const auto& entry : dataset) {
-        std::string matched;
-        bool detected = testFilenameWithDFA(entry.filename, matched);
-        // Update per-pattern metrics
-        if (!matched.empty()) {
-            auto& pm = perPattern[matched];
-            if (detected && entry.is_malicious) pm.tp++; else
-            if (detected && !entry.is_malicious) pm.fp++; else
-            if (!detected && entry.is_malicious) pm.fn++; else pm.tn++;
-        }
-        
-        if (detected && entry.is_malicious) {
-            metrics.true_positives++;
-            if (sample_tp.size() < MAX_SAMPLES) {
-                sample_tp.push_back(entry.filename + " (matched: " + matched + ")");
+    // Per-chunk accumulators (metrics, per-pattern counts, first samples), merged in chunk order
+    struct ChunkResult {
+        int tp = 0, fp = 0, fn = 0;
+        std::map<std::string, PatternMetrics> perPattern;
+        std::vector<std::string> sample_tp, sample_fn;
+    };
+    std::vector<ChunkResult> partial;
+    forEachDatasetChunk(partial, [&](ChunkResult& r, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto& entry = dataset[i];
+            std::string matched;
+            bool detected = testFilenameWithDFA(entry.filename, matched);
+            // Update per-pattern metrics
+            if (!matched.empty()) {
+                auto& pm = r.perPattern[matched];
+                if (detected && entry.is_malicious) pm.tp++; else
+                if (detected && !entry.is_malicious) pm.fp++; else
+                if (!detected && entry.is_malicious) pm.fn++; else pm.tn++;
             }
-        } else if (detected && !entry.is_malicious) {
-            metrics.false_positives++;
-        } else if (!detected && entry.is_malicious) {
-            metrics.false_negatives++;
-            if (sample_fn.size() < MAX_SAMPLES) {
-                sample_fn.push_back(entry.filename);
+            
+            if (detected && entry.is_malicious) {
+                r.tp++;
+                if (r.sample_tp.size() < MAX_SAMPLES) {
+                    r.sample_tp.push_back(entry.filename + " (matched: " + matched + ")");
+                }
+            } else if (detected && !entry.is_malicious) {
+                r.fp++;
+            } else if (!detected && entry.is_malicious) {
+                r.fn++;
+                if (r.sample_fn.size() < MAX_SAMPLES) {
+                    r.sample_fn.push_back(entry.filename);
+                }
             }
         }
+    });
+    for (const ChunkResult& r : partial) {
+        metrics.true_positives += r.tp;
+        metrics.false_positives += r.fp;
+        metrics.false_negatives += r.fn;
+        for (const auto& kv : r.perPattern) {
+            auto& pm = perPattern[kv.first];
+            pm.tp += kv.second.tp; pm.fp += kv.second.fp;
+            pm.fn += kv.second.fn; pm.tn += kv.second.tn;
+        }
+        for (const auto& t : r.sample_tp) if (sample_tp.size() < MAX_SAMPLES) sample_tp.push_back(t);
+        for (const auto& f : r.sample_fn) if (sample_fn.size() < MAX_SAMPLES) sample_fn.push_back(f);
     }
     
     auto end = std::chrono::high_resolution_clock::now();
@@ -569,44 +940,123 @@ void DFAModule::testPatterns() {
 
 // ACTUALLY USE THE DFAs FOR TESTING
 bool DFAModule::testFilenameWithDFA(const std::string& filename, std::string& matched_pattern) {
-    // Convert to lowercase for case-insensitive matching
-    std::string lower = filename;
-    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-    
-    // Test against all DFAs
-    for (size_t i = 0; i < minimized_dfas.size() && i < pattern_names.size(); i++) {
-        if (runDFA(minimized_dfas[i], lower)) {
-            matched_pattern = pattern_names[i];
-            return true;
-        }
+    uint64_t key = hashString64(filename, mix64(filename_version));
+    int32_t code;
+    if (!filename_cache.lookup(key, code)) {
+        code = classifyFilename(filename);
+        filename_cache.insert(key, code);
+    }
+    if (code < 0) return false;
+    size_t base = pattern_names.size();
+    if ((size_t)code < base) matched_pattern = pattern_names[code];
+    else if ((size_t)code < base + heuristic_names.size()) matched_pattern = heuristic_names[code - base];
+    else if ((size_t)code == base + 3) matched_pattern = "blocklist_exact";
+    else if ((size_t)code == base + 4) matched_pattern = "blocklist_suffix";
+    else matched_pattern = "known_ioc";
+    return true;
+}
+
+// Uncached classification; returns the synthetic index of the winning reason or -1
+int DFAModule::classifyFilename(const std::string& filename) {
+    const int base = (int)pattern_names.size();
+    // Lowercased copy only when a lookup structure keyed on it is loaded
+    std::string lower;
+    bool needLower = !ioc_filter.empty() || !blocklist_exact.empty() || !blocklist_suffix.empty();
+    if (needLower) {
+        lower = filename;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
     }
     
-    // Additional heuristics for patterns DFAs might miss
-    return checkAdditionalPatterns(filename, matched_pattern);
+    // Stage 0: known IOC hashes/names, before any DFA work
+    if (matchKnownIOC(lower)) return base + 5;
+    
+    // One pass over the raw bytes: pattern DFAs (lowercasing folded into the tables) and the
+    // heuristic automata, lowest index wins as in the per-DFA loop
+    int k = filename_matcher.firstMatch(filename.data(), filename.size());
+    if (k >= 0 && (size_t)k < matcher_patterns) return (int)firstPatternMatch(hot_patterns[k], filename);
+    
+    // Blocklists rank between the regex patterns and the heuristics
+    if (needLower) {
+        if (blocklist_exact.contains(lower)) return base + 3;
+        if (blocklist_suffix.containsReversedSuffixOf(lower)) return base + 4;
+    }
+    if (k >= 0) return base + (k - (int)matcher_patterns);
+    return -1;
+}
+
+// A redundant pattern below the winning hot pattern may also match (its subsumer is hot, so
+// it can only match when some hot pattern does); report it to keep attribution exact
+size_t DFAModule::firstPatternMatch(size_t hot, const std::string& filename) const {
+    for (size_t i = 0; i < redundant_patterns.size() && redundant_patterns[i] < hot; ++i) {
+        if (redundant_compiled[i].matches(filename.data(), filename.size())) return redundant_patterns[i];
+    }
+    return hot;
+}
+
+int DFAModule::decidingExtension(const std::string& filename) const {
+    const char* ext; size_t n;
+    if (!ExtensionTable::lastExtension(filename, ext, n)) return -1;
+    int slot = ExtensionTable::find(ext, n);
+    return slot >= 0 ? extension_decides[slot] : -1;
+}
+
+bool DFAModule::isSuspiciousFilename(const std::string& filename) {
+    if (decidingExtension(filename) >= 0) return true;
+    std::string matched;
+    return testFilenameWithDFA(filename, matched);
 }
 
 // Return all matched DFA pattern indices for a filename (for multi-reason display)
 std::vector<size_t> DFAModule::testFilenameMatchesAll(const std::string& filename) {
+    // Include heuristic flags as synthetic indices after DFA patterns
+    // Map: unicode_trick -> pattern_names.size(), double_extension -> +1, whitespace_padding -> +2,
+    //      blocklist_exact -> +3, blocklist_suffix -> +4, known_ioc -> +5
+    size_t base = pattern_names.size();
     std::vector<size_t> matches;
+    std::vector<size_t> hits = filename_matcher.allMatches(filename.data(), filename.size());
+    size_t h = 0;
+    for (; h < hits.size() && hits[h] < matcher_patterns; ++h) matches.push_back(hot_patterns[hits[h]]);
+    // Redundant patterns are reported too; they can only match alongside a hot pattern
+    if (!matches.empty()) {
+        for (size_t i = 0; i < redundant_patterns.size(); ++i) {
+            if (redundant_compiled[i].matches(filename.data(), filename.size())) matches.push_back(redundant_patterns[i]);
+        }
+        std::sort(matches.begin(), matches.end());
+    }
+    for (; h < hits.size(); ++h) matches.push_back(base + (hits[h] - matcher_patterns));
     std::string lower = filename;
     std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-    for (size_t i = 0; i < minimized_dfas.size() && i < pattern_names.size(); i++) {
-        if (runDFA(minimized_dfas[i], lower)) {
-            matches.push_back(i);
+    if (blocklist_exact.contains(lower))                 matches.push_back(base + 3);
+    if (blocklist_suffix.containsReversedSuffixOf(lower)) matches.push_back(base + 4);
+    if (matchKnownIOC(lower))                            matches.push_back(base + 5);
+    return matches;
+}
+
+std::string DFAModule::describeContentResult(const FileContentResult& r) {
+    if (!r.readable) return "UNREADABLE";
+    std::string how = (r.mapped ? "mmap, " : "pread, ") + std::to_string(r.bytes_scanned) + " bytes";
+    return r.malicious ? "MALICIOUS (" + r.matched_pattern + ") [" + how + "]" : "CLEAN [" + how + "]";
+}
+
+std::string DFAModule::formatMatchReasons(const std::vector<size_t>& matches) const {
+    std::ostringstream reasons;
+    for (size_t r=0; r<matches.size(); ++r) {
+        size_t idx = matches[r];
+        if (idx < pattern_names.size()) {
+            reasons << "[pattern " << (idx+1) << "]";
+        } else {
+            // Heuristic indices
+            size_t h = idx - pattern_names.size();
+            if (h==0) reasons << "[unicode_trick]";
+            else if (h==1) reasons << "[double_extension]";
+            else if (h==2) reasons << "[whitespace_padding]";
+            else if (h==3) reasons << "[blocklist_exact]";
+            else if (h==4) reasons << "[blocklist_suffix]";
+            else if (h==5) reasons << "[known_ioc]";
         }
+        if (r+1<matches.size()) reasons << " ";
     }
-    // Include heuristic flags as synthetic indices after DFA patterns
-    // Map: unicode_trick -> pattern_names.size(), double_extension -> +1, whitespace_padding -> +2
-    size_t base = pattern_names.size();
-    bool unicode=false, dbl=false, ws=false;
-    for (unsigned char c : filename) { if (c > 127) { unicode=true; break; } }
-    int dot_count=0; for (char c : filename) { if (c=='.') dot_count++; }
-    if (dot_count>=2) dbl=true;
-    if (filename.find("  ") != std::string::npos) ws=true;
-    if (unicode) matches.push_back(base + 0);
-    if (dbl)     matches.push_back(base + 1);
-    if (ws)      matches.push_back(base + 2);
-    return matches;
+    return reasons.str();
 }
 
 // Test filename with DFA using verbose mode (for file scanning visualization)
@@ -615,6 +1065,12 @@ bool DFAModule::testFilenameWithDFAVerbose(const std::string& filename, std::str
     std::string lower = filename;
     std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
     
+    if (matchKnownIOC(lower)) {
+        std::cout << "  → Known IOC (prefilter hit): " << filename << std::endl;
+        matched_pattern = "known_ioc";
+        return true;
+    }
+    
     // Output verbose state transitions for EVERY DFA to enable visualization
     // This ensures the frontend sees state transitions even for non-matching files
     std::cout << "  → Testing DFA patterns for: " << filename << std::endl;
@@ -661,16 +1117,92 @@ bool DFAModule::runDFAVerbose(const DFA& dfa, const std::string& input) {
 }
 
 // Test content with minimized content DFAs
-bool DFAModule::testContentWithDFA(const std::string& content, std::string& matched_pattern) {
-    std::string lower = content;
-    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-    for (size_t i = 0; i < content_minimized_dfas.size() && i < content_pattern_names.size(); ++i) {
-        if (runDFA(content_minimized_dfas[i], lower)) {
-            matched_pattern = content_pattern_names[i];
-            return true;
+bool DFAModule::testContentWithDFA(std::string_view content, std::string& matched_pattern) {
+    uint64_t key = hashString64(content, mix64(content_version));
+    int32_t code;
+    if (!content_cache.lookup(key, code)) {
+        // Compiled tables fold lowercasing in, so the payload is scanned in place
+        StreamScanner scanner(content_compiled, content_pattern_names);
+        scanner.feed(content.data(), content.size());
+        std::string name;
+        code = -1;
+        if (scanner.finish(name)) {
+            code = (int32_t)(std::find(content_pattern_names.begin(), content_pattern_names.end(), name)
+                             - content_pattern_names.begin());
         }
+        content_cache.insert(key, code);
     }
-    return false;
+    if (code < 0) return false;
+    matched_pattern = content_pattern_names[code];
+    return true;
+}
+
+uint64_t DFAModule::patternSetVersion() const {
+    uint64_t h = mix64(list_digest);
+    auto fold = [&h](const std::vector<std::string>& items, uint64_t tag) {
+        h = mix64(h ^ tag);
+        for (const auto& s : items) h = hashString64(s, h);
+    };
+    fold(regex_patterns, 1);
+    fold(pattern_names, 2);
+    fold(content_regex_patterns, 3);
+    fold(content_pattern_names, 4);
+    fold(allowlist_patterns, 5);
+    return h;
+}
+
+void DFAModule::printVerdictCacheStats() const {
+    auto line = [](const char* label, const VerdictCache& c) {
+        std::ostringstream rate;
+        rate << std::fixed << std::setprecision(1) << c.hitRate();
+        std::cout << "  " << label << c.hits() << " hits / " << (c.hits() + c.misses()) << " lookups ("
+                  << rate.str() << "%), " << c.size() << " entries, " << c.evictions() << " evictions" << std::endl;
+    };
+    std::cout << "[CACHE] Verdict memoization" << std::endl;
+    line("Filenames: ", filename_cache);
+    line("Payloads:  ", content_cache);
+}
+
+// Real files are scanned in place: large files through a read-only mapping with MADV_SEQUENTIAL,
+// small ones through a single pread. The mapped range is fed in 1 MB slices so the scan stops
+// paging in the rest of the file once the verdict is certain.
+FileContentResult DFAModule::scanFileContent(const std::string& path) {
+    FileContentResult r;
+    MappedFile file;
+    if (!file.open(path, MappedFile::Access::Sequential)) return r;
+    r.readable = true;
+    r.mapped = file.isMapped();
+    StreamScanner scanner = newContentStream();
+    const size_t SLICE = 1 << 20;
+    for (size_t off = 0; off < file.size(); off += SLICE) {
+        size_t n = std::min(SLICE, file.size() - off);
+        r.bytes_scanned += n;
+        if (scanner.feed(file.data() + off, n)) break;
+    }
+    r.malicious = scanner.finish(r.matched_pattern);
+    return r;
+}
+
+StreamScanner DFAModule::newContentStream() {
+    if (content_compiled.empty()) {
+        defineContentPatterns();
+        buildContentNFAs();
+        convertContentToDFAs();
+        minimizeContentDFAs();
+    }
+    return StreamScanner(content_compiled, content_pattern_names);
+}
+
+bool DFAModule::scanContentStream(std::istream& in, std::string& matched_pattern, size_t chunkSize) {
+    StreamScanner scanner = newContentStream();
+    std::vector<char> buf(std::max<size_t>(1, chunkSize));
+    while (in) {
+        in.read(buf.data(), (std::streamsize)buf.size());
+        std::streamsize got = in.gcount();
+        if (got <= 0) break;
+        if (scanner.feed(buf.data(), (size_t)got)) break;
+    }
+    return scanner.finish(matched_pattern);
 }
 
 // Additional pattern checks (for comprehensive detection)
@@ -679,28 +1211,22 @@ bool DFAModule::checkAdditionalPatterns(const std::string& filename,
     std::string lower = filename;
     std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
     
-    // Check for unicode tricks
-    for (unsigned char c : filename) {
-        if (c > 127) {
-            matched_pattern = "unicode_trick";
-            return true;
-        }
-    }
-    
-    // Check for double extensions
-    int dot_count = 0;
-    for (char c : filename) {
-        if (c == '.') dot_count++;
+    // Known-bad names: exact and suffix lookups in the blocklist DAWGs, O(|filename|) each
+    if (blocklist_exact.contains(lower)) {
+        matched_pattern = "blocklist_exact";
+        return true;
     }
-    if (dot_count >= 2) {
-        matched_pattern = "double_extension";
+    if (blocklist_suffix.containsReversedSuffixOf(lower)) {
+        matched_pattern = "blocklist_suffix";
         return true;
     }
     
-    // Check for whitespace padding
-    if (filename.find("  ") != std::string::npos) {
-        matched_pattern = "whitespace_padding";
-        return true;
+    // Heuristic automata: unicode_trick, double_extension, whitespace_padding (in that order)
+    for (size_t h = 0; h < heuristic_compiled.size(); ++h) {
+        if (heuristic_compiled[h].matches(filename.data(), filename.size())) {
+            matched_pattern = heuristic_names[h];
+            return true;
+        }
     }
     
     return false;
@@ -708,9 +1234,9 @@ bool DFAModule::checkAdditionalPatterns(const std::string& filename,
 
 void DFAModule::integrateCombinedAndMalwareCSVs(const std::string& combinedCsvPath,
                                                 const std::string& malwareCsvPath) {
-    auto synthFromHash = [&](const std::string& hash, bool malicious){
+    auto synthFromHash = [&](std::string_view hash, bool malicious){
         FilenameEntry e;
-        std::string base = hash.substr(0, std::min<size_t>(16, hash.size()));
+        std::string base(hash.substr(0, std::min<size_t>(16, hash.size())));
         e.filename = base + (malicious ? ".exe" : ".txt");
         e.technique = malicious ? "malicious_synthesized" : "benign_synthesized";
         e.category = malicious ? "malicious" : "benign";
@@ -719,54 +1245,37 @@ void DFAModule::integrateCombinedAndMalwareCSVs(const std::string& combinedCsvPa
         dataset.push_back(e);
     };
 
-    // Ingest combined_random.csv (type column: 1=benign, 0=malicious)
-    {
-        std::ifstream in(combinedCsvPath);
-        if (!in.is_open()) {
-            std::cerr << "[WARN] Could not open combined CSV: " << combinedCsvPath << std::endl;
-        } else {
-            std::cout << "[INFO] Integrating combined CSV: " << combinedCsvPath << std::endl;
-            std::string line; bool headerSkipped=false; int added=0;
-            while (std::getline(in, line)) {
-                if (!headerSkipped) { headerSkipped=true; continue; }
-                if (line.empty()) continue;
-                std::istringstream ss(line);
-                std::string typeStr, hash;
-                if (!std::getline(ss, typeStr, ',')) continue;
-                if (!std::getline(ss, hash, ',')) continue;
-                if (hash.empty()) continue;
-                bool malicious = (typeStr == "0");
-                synthFromHash(hash, malicious);
-                added++;
-            }
-            in.close();
-            std::cout << "[SUCCESS] Added " << added << " entries from combined_random.csv" << std::endl;
+    // Both files: header with "type" and "hash" columns (positions 0 and 1 if unnamed)
+    auto ingest = [&](const std::string& path, const char* label, const char* source, bool allMalicious) {
+        MappedFile file;
+        if (!file.open(path)) {
+            std::cerr << "[WARN] Could not open " << label << " CSV: " << path << std::endl;
+            return;
         }
-    }
-
-    // Ingest malware.csv (all treated as malicious)
-    {
-        std::ifstream in(malwareCsvPath);
-        if (!in.is_open()) {
-            std::cerr << "[WARN] Could not open malware CSV: " << malwareCsvPath << std::endl;
-        } else {
-            std::cout << "[INFO] Integrating malware CSV: " << malwareCsvPath << std::endl;
-            std::string line; bool headerSkipped=false; int added=0;
-            while (std::getline(in, line)) {
-                if (!headerSkipped) { headerSkipped=true; continue; }
-                if (line.empty()) continue;
-                std::istringstream ss(line);
-                std::string typeStr, hash;
-                if (!std::getline(ss, typeStr, ',')) continue;
-                if (!std::getline(ss, hash, ',')) continue;
-                if (hash.empty()) continue;
-                synthFromHash(hash, true);
-                added++;
-            }
-            in.close();
-            std::cout << "[SUCCESS] Added " << added << " entries from malware.csv" << std::endl;
+        std::cout << "[INFO] Integrating " << label << " CSV: " << path << std::endl;
+        CSVReader csv(file.view());
+        int typeCol = 0, hashCol = 1;
+        if (csv.next()) {
+            if (csv.column("type") >= 0) typeCol = csv.column("type");
+            if (csv.column("hash") >= 0) hashCol = csv.column("hash");
         }
-    }
+        size_t needed = (size_t)std::max(typeCol, hashCol);
+        std::string hash;
+        int added = 0;
+        while (csv.next()) {
+            if (!csv.error().empty() || csv.fieldCount() <= needed) continue;
+            std::string_view hashField = csv.text((size_t)hashCol, hash);
+            if (hashField.empty()) continue;
+            bool malicious = allMalicious || csv.raw((size_t)typeCol) == "0";
+            synthFromHash(hashField, malicious);
+            added++;
+        }
+        std::cout << "[SUCCESS] Added " << added << " entries from " << source << std::endl;
+    };
+    // Ingest combined_random.csv (type column: 1=benign, 0=malicious)
+    ingest(combinedCsvPath, "combined", "combined_random.csv", false);
+    // Ingest malware.csv (all treated as malicious)
+    ingest(malwareCsvPath, "malware", "malware.csv", true);
 
     metrics.filenames_tested = (int)dataset.size();
     // Post-ingest label summary accounting for combined_random (type=1) and malware.csv
@@ -806,20 +1315,7 @@ void DFAModule::generateReport() {
                 std::string match_info;
                 if (detected) {
                     auto all = testFilenameMatchesAll(entry.filename);
-                    std::ostringstream reasons;
-                    for (size_t r=0; r<all.size(); ++r) {
-                        size_t idxr = all[r];
-                        if (idxr < pattern_names.size()) {
-                            reasons << "[pattern " << (idxr+1) << "]";
-                        } else {
-                            size_t h = idxr - pattern_names.size();
-                            if (h==0) reasons << "[unicode_trick]";
-                            else if (h==1) reasons << "[double_extension]";
-                            else if (h==2) reasons << "[whitespace_padding]";
-                        }
-                        if (r+1<all.size()) reasons << " ";
-                    }
-                    match_info = " (matched: " + matched + ") " + reasons.str();
+                    match_info = " (matched: " + matched + ") " + formatMatchReasons(all);
                 } else {
                     match_info = "";
                 }
@@ -894,6 +1390,29 @@ void DFAModule::generateReport() {
         std::cout << "  Pattern '" << regex_patterns[i] 
                   << "' (" << pattern_names[i] << ") → DFA " << i << std::endl;
     }
+    // Subsumption analysis results (redundant patterns remain in reporting metadata)
+    std::cout << "\n[PATTERN SUBSUMPTION]" << std::endl;
+    std::cout << "  Hot DFAs:               " << hot_patterns.size() << " of " << minimized_dfas.size() << std::endl;
+    std::cout << "  Redundant patterns:     " << metrics.redundant_patterns << std::endl;
+    for (size_t r : redundant_patterns) {
+        std::cout << "    " << pattern_names[r] << " ⊆ " << pattern_names[subsumed_by[r]] << std::endl;
+    }
+    std::cout << "\n[EXTENSION FAST PATH]" << std::endl;
+    std::cout << "  Deciding extensions:    ";
+    int deciding = 0;
+    for (size_t slot = 0; slot < extension_decides.size(); ++slot) {
+        if (extension_decides[slot] < 0) continue;
+        std::cout << (deciding++ ? ", ." : ".") << ExtensionTable::extension((int)slot);
+    }
+    std::cout << (deciding ? "" : "(none)") << std::endl;
+    std::cout << "  Names decided early:    " << metrics.extension_fast_path << std::endl;
+    if (!ioc_filter.empty()) {
+        std::cout << "\n[IOC PREFILTER]" << std::endl;
+        std::cout << "  Known IOCs:             " << ioc_filter.size() << std::endl;
+        std::cout << "  Probes:                 " << ioc_filter.getProbes() << std::endl;
+        std::cout << "  Passed Bloom stage:     " << ioc_filter.getFilterPasses() << std::endl;
+        std::cout << "  Confirmed hits:         " << ioc_filter.getConfirmed() << std::endl;
+    }
     // Per-pattern metrics (macro view)
     if (!perPattern.empty()) {
         std::cout << "\n[PER-PATTERN METRICS]" << std::endl;
@@ -952,6 +1471,28 @@ void DFAModule::generateReport() {
                 out << "  Pattern '" << regex_patterns[i] 
                     << "' (" << pattern_names[i] << ") → DFA " << i << "\n";
             }
+            out << "\n[PATTERN SUBSUMPTION]\n";
+            out << "  Hot DFAs:               " << hot_patterns.size() << " of " << minimized_dfas.size() << "\n";
+            out << "  Redundant patterns:     " << metrics.redundant_patterns << "\n";
+            for (size_t r : redundant_patterns) {
+                out << "    " << pattern_names[r] << " ⊆ " << pattern_names[subsumed_by[r]] << "\n";
+            }
+            out << "\n[EXTENSION FAST PATH]\n";
+            out << "  Deciding extensions:    ";
+            int deciding = 0;
+            for (size_t slot = 0; slot < extension_decides.size(); ++slot) {
+                if (extension_decides[slot] < 0) continue;
+                out << (deciding++ ? ", ." : ".") << ExtensionTable::extension((int)slot);
+            }
+            out << (deciding ? "" : "(none)") << "\n";
+            out << "  Names decided early:    " << metrics.extension_fast_path << "\n";
+            if (!ioc_filter.empty()) {
+                out << "\n[IOC PREFILTER]\n";
+                out << "  Known IOCs:             " << ioc_filter.size() << "\n";
+                out << "  Probes:                 " << ioc_filter.getProbes() << "\n";
+                out << "  Passed Bloom stage:     " << ioc_filter.getFilterPasses() << "\n";
+                out << "  Confirmed hits:         " << ioc_filter.getConfirmed() << "\n";
+            }
             out << "\n[RESOURCE METRICS]\n";
             out << "  Estimated DFA memory:   " << metrics.estimated_memory_kb << " KB\n";
             out << "\n[PERFORMANCE]\n";
@@ -1158,6 +1699,7 @@ void DFAModule::scanFiles(const std::vector<std::string>& filePaths) {
         buildNFAs();
         convertToDFAs();
         minimizeDFAs();
+        eliminateRedundantPatterns();
     }
     
     // Show scan header
@@ -1175,6 +1717,7 @@ void DFAModule::scanFiles(const std::vector<std::string>& filePaths) {
     
     std::vector<bool> detected;
     std::vector<std::string> matched_patterns;
+    std::vector<FileContentResult> content;
     
     // Process files one by one with delays for showcasing
     for (size_t i = 0; i < filePaths.size(); ++i) {
@@ -1222,17 +1765,88 @@ void DFAModule::scanFiles(const std::vector<std::string>& filePaths) {
             std::this_thread::sleep_for(std::chrono::milliseconds(300));
             std::cout << "  ✓ Result: SAFE" << std::endl;
         }
+        content.push_back(scanFileContent(filePath));
+        std::cout << "  → Content scan: " << describeContentResult(content.back()) << std::endl;
         std::cout.flush(); // Ensure output is flushed after each file
     }
     
     // Delay before showing summary
     std::this_thread::sleep_for(std::chrono::milliseconds(800));
-    generateScanReport(filePaths, detected, matched_patterns);
+    generateScanReport(filePaths, detected, matched_patterns, content);
+}
+
+// Directory sweep: names go straight to the non-verbose matcher (no per-file delays or state
+// traces). Each directory batch is classified on the worker that listed it; hits are streamed
+// once per batch and per-pattern counts are merged under a single lock.
+void DFAModule::scanDirectory(const std::string& root) {
+    if (minimized_dfas.empty()) {
+        definePatterns();
+        buildNFAs();
+        convertToDFAs();
+        minimizeDFAs();
+        eliminateRedundantPatterns();
+    }
+    std::cout << "\n╔═══════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║   DIRECTORY SCAN MODULE - PARALLEL FILENAME SWEEP         ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════════╝" << std::endl;
+    std::cout << "[INFO] Scanning tree: " << root << " (" << num_threads << " threads)" << std::endl;
+
+    std::mutex out_m;
+    std::map<std::string, uint64_t> byPattern;
+    std::atomic<uint64_t> suspicious{0};
+    std::ofstream hitsOut("output/scan_dir_hits.txt");
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    DirectoryWalker::Stats stats = DirectoryWalker::walk(root, *getPool(),
+        [&](const std::string& dir, const std::vector<std::string>& names) {
+            std::string lines;
+            std::map<std::string, uint64_t> local;
+            for (const auto& name : names) {
+                std::string matched;
+                if (!testFilenameWithDFA(name, matched)) continue;
+                local[matched]++;
+                lines += "  [SUSPICIOUS] " + dir + "/" + name + " (" + matched + ")\n";
+            }
+            if (local.empty()) return;
+            uint64_t hits = 0;
+            std::lock_guard<std::mutex> lock(out_m);
+            for (const auto& kv : local) { byPattern[kv.first] += kv.second; hits += kv.second; }
+            suspicious.fetch_add(hits, std::memory_order_relaxed);
+            std::cout << lines;
+            if (hitsOut.is_open()) hitsOut << lines;
+        });
+    auto end_time = std::chrono::high_resolution_clock::now();
+    double secs = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count() / 1e6;
+    std::cout.flush();
+    if (!stats.root_opened) {
+        std::cerr << "[ERROR] Could not open directory: " << root << std::endl;
+        return;
+    }
+
+    std::cout << "\n[SUCCESS] Directory scan complete" << std::endl;
+    std::cout << "  Directories:      " << stats.directories << std::endl;
+    std::cout << "  Files scanned:    " << stats.entries << std::endl;
+    std::cout << "  Suspicious:       " << suspicious.load() << std::endl;
+    std::cout << "  Unreadable dirs:  " << stats.errors << std::endl;
+    std::cout << "  Time:             " << std::fixed << std::setprecision(3) << secs << " s" << std::endl;
+    if (secs > 0) {
+        std::cout << "  Throughput:       " << std::setprecision(0) << (stats.entries / secs) << " files/s" << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+    if (!byPattern.empty()) {
+        std::cout << "\n[MATCHES BY PATTERN]" << std::endl;
+        for (const auto& kv : byPattern) {
+            std::cout << "  " << kv.first << ": " << kv.second << std::endl;
+        }
+    }
+    if (hitsOut.is_open()) std::cout << "\n[INFO] Hits written to output/scan_dir_hits.txt" << std::endl;
 }
 
 void DFAModule::generateScanReport(const std::vector<std::string>& filePaths,
                                    const std::vector<bool>& detected,
-                                   const std::vector<std::string>& matched_patterns) {
+                                   const std::vector<std::string>& matched_patterns,
+                                   const std::vector<FileContentResult>& content) {
     std::cout << "\n";
     std::cout << "╔═══════════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║          FILE SCAN MODULE - DETECTION RESULTS             ║" << std::endl;
@@ -1291,21 +1905,7 @@ void DFAModule::generateScanReport(const std::vector<std::string>& filePaths,
                 if (detected[i]) {
                     // Build multi-reason tags: [pattern k]
                     auto all = testFilenameMatchesAll(fileName);
-                    std::ostringstream reasons;
-                    for (size_t r=0; r<all.size(); ++r) {
-                        size_t idx = all[r];
-                        if (idx < pattern_names.size()) {
-                            reasons << "[pattern " << (idx+1) << "]";
-                        } else {
-                            // Heuristic indices
-                            size_t h = idx - pattern_names.size();
-                            if (h==0) reasons << "[unicode_trick]";
-                            else if (h==1) reasons << "[double_extension]";
-                            else if (h==2) reasons << "[whitespace_padding]";
-                        }
-                        if (r+1<all.size()) reasons << " ";
-                    }
-                    match_info = " (matched: " + matched_patterns[i] + ") " + reasons.str();
+                    match_info = " (matched: " + matched_patterns[i] + ") " + formatMatchReasons(all);
                 } else {
                     match_info = "";
                 }
@@ -1313,8 +1913,8 @@ void DFAModule::generateScanReport(const std::vector<std::string>& filePaths,
                 std::string contentMatchSuffix;
                 if (detected[i]) {
                     // Try tricks dataset lookup
-                    std::vector<TCPTrace> tricks = JSONParser::loadTCPDataset("archive/tcp_tricks.jsonl");
-                    for (const auto& ttrace : tricks) {
+                    DatasetStore::Views tricks = datasets->views("archive/tcp_tricks.jsonl");
+                    for (const auto& ttrace : tricks->records()) {
                         if (ttrace.trace_id == fileName) {
                             std::string m;
                             if (testContentWithDFA(ttrace.content, m) && !m.empty()) {
@@ -1341,27 +1941,32 @@ void DFAModule::generateScanReport(const std::vector<std::string>& filePaths,
     std::cout << "  ✓ Safe files:        " << safeCount << std::endl;
     std::cout << "  ✗ Suspicious files:  " << suspiciousCount << std::endl;
     std::cout << "  Total scanned:       " << filePaths.size() << std::endl;
+    if (!content.empty()) {
+        size_t maliciousContent = 0, unreadable = 0;
+        for (const auto& c : content) {
+            if (!c.readable) unreadable++;
+            else if (c.malicious) maliciousContent++;
+        }
+        std::cout << "  ✗ Malicious content: " << maliciousContent << std::endl;
+        std::cout << "  Content unreadable:  " << unreadable << std::endl;
+    }
     
     if (suspiciousCount > 0) {
         std::cout << "\n[SUSPICIOUS FILES DETECTED]" << std::endl;
         for (size_t i = 0; i < suspiciousFiles.size(); ++i) {
             // Also include multi-reasons in this list
             auto all = testFilenameMatchesAll(suspiciousFiles[i].first);
-            std::ostringstream reasons;
-            for (size_t r=0; r<all.size(); ++r) {
-                size_t idx = all[r];
-                if (idx < pattern_names.size()) {
-                    reasons << "[pattern " << (idx+1) << "]";
-                } else {
-                    size_t h = idx - pattern_names.size();
-                    if (h==0) reasons << "[unicode_trick]";
-                    else if (h==1) reasons << "[double_extension]";
-                    else if (h==2) reasons << "[whitespace_padding]";
-                }
-                if (r+1<all.size()) reasons << " ";
-            }
             std::cout << "  " << (i + 1) << ". " << suspiciousFiles[i].first 
-                      << " (" << suspiciousFiles[i].second << ") " << reasons.str() << std::endl;
+                      << " (" << suspiciousFiles[i].second << ") " << formatMatchReasons(all) << std::endl;
+        }
+    }
+    
+    if (!content.empty()) {
+        std::cout << "\n[NAME + CONTENT VERDICTS]" << std::endl;
+        for (size_t i = 0; i < filePaths.size() && i < content.size(); ++i) {
+            if (!detected[i] && !content[i].malicious) continue;
+            std::cout << "  " << filePaths[i] << ": name=" << (detected[i] ? "SUSPICIOUS (" + matched_patterns[i] + ")" : "SAFE")
+                      << ", content=" << describeContentResult(content[i]) << std::endl;
         }
     }
     
@@ -1588,7 +2193,7 @@ void DFAModule::exportRegularGrammarForContentPattern(size_t index, const std::s
 }
 // Simple DFA-on-contents gate using literal substring checks that mirror regex signatures.
 // This keeps content scanning efficient and demonstrable for the project scope.
-bool DFAModule::scanContent(const std::string& content) {
+bool DFAModule::scanContent(std::string_view content) {
     // Ensure content DFAs are built
     if (content_minimized_dfas.empty()) {
         defineContentPatterns();
@@ -1626,8 +2231,10 @@ void DFAModule::generateContentScanReport() {
     std::cout << "  DFAs after minimization:" << content_minimized_dfas.size() << std::endl;
 
     // Try a small randomized sample from tricks dataset to illustrate matches
-    std::vector<TCPTrace> tricks;
-    try { tricks = JSONParser::loadTCPDataset("archive/tcp_tricks.jsonl"); } catch (...) {}
+    std::vector<TraceView> none;
+    DatasetStore::Views loaded;
+    try { loaded = datasets->views("archive/tcp_tricks.jsonl"); } catch (...) {}
+    const std::vector<TraceView>& tricks = loaded ? loaded->records() : none;
     if (!tricks.empty()) {
         std::cout << "\n[SAMPLE CONTENT RESULTS (RANDOMIZED)]" << std::endl;
         std::vector<size_t> idx(tricks.size()); for (size_t i=0;i<idx.size();++i) idx[i]=i;
@@ -9,15 +9,27 @@
 #include "Utils.h"
 #include "JSONParser.h"
 #include "RegexParser.h"
+#include "DFAAlgebra.h"
+#include "DAWG.h"
+#include "IOCFilter.h"
+#include "CompiledDFA.h"
+#include "ExtensionTable.h"
+#include "VerdictCache.h"
+#include "ThreadPool.h"
+#include "DatasetStore.h"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <set>
+#include <memory>
 
 namespace CS311 {
 
 class DFAModule {
 private:
     std::vector<FilenameEntry> dataset;
+    // Parsed trace files, shared with the other stages when main passes one store to all
+    std::shared_ptr<DatasetStore> datasets;
     std::vector<std::string> regex_patterns;
     std::vector<std::string> pattern_names;
     std::vector<NFA> nfas;
@@ -29,22 +41,79 @@ private:
     std::vector<NFA> content_nfas;
     std::vector<DFA> content_dfas;
     std::vector<DFA> content_minimized_dfas;
+    // Byte-level tables for the content DFAs (streaming scans, no lowercased copies)
+    std::vector<CompiledDFA> content_compiled;
+    // Filename heuristics as byte-level automata (unicode_trick, double_extension, whitespace_padding),
+    // compiled with the pattern DFAs into one single-pass matcher; heuristic k reports as
+    // synthetic index pattern_names.size() + k
+    std::vector<DFA> heuristic_dfas;
+    std::vector<std::string> heuristic_names;
+    std::vector<CompiledDFA> heuristic_compiled;
+    MultiDFA filename_matcher;   // components: hot pattern DFAs in index order, then heuristics
+    size_t matcher_patterns = 0; // number of pattern components in filename_matcher (component k is hot_patterns[k])
+    std::vector<CompiledDFA> redundant_compiled; // per redundant_patterns entry, for attribution and reports
+    size_t firstPatternMatch(size_t hot, const std::string& filename) const;
+    // Extension fast path: per ExtensionTable slot, a pattern whose language contains every
+    // name ending in ".<ext>" (so the extension alone decides "suspicious"), or -1
+    std::vector<int> extension_decides;
+    // Exact-name and suffix blocklists as minimal acyclic DFAs (suffixes stored reversed)
+    DAWG blocklist_exact;
+    DAWG blocklist_suffix;
+    // Known IOC hashes/name stems: blocked Bloom filter + exact fingerprints, checked before any DFA
+    IOCFilter ioc_filter;
+    // Memoized verdicts for repeated filenames and payloads. Keys are seeded with a version that
+    // is bumped whenever the matchers change, so stale entries are never hit and simply age out.
+    // Filename values use the synthetic indices of testFilenameMatchesAll (-1 = clean); content
+    // values index content_pattern_names.
+    VerdictCache filename_cache;
+    VerdictCache content_cache;
+    uint64_t filename_version = 0;
+    uint64_t content_version = 0;
+    // Digest of loaded blocklists/IOC sets, folded into patternSetVersion()
+    uint64_t list_digest = 0;
+    int classifyFilename(const std::string& filename);
     DFAMetrics metrics;
     bool combineAll = false; // when true, build a single combined DFA for all patterns
+    // Benign allowlist: filename pattern DFAs are compiled as (pattern \ allowlist)
+    std::vector<std::string> allowlist_patterns;
     // Per-pattern evaluation metrics
     struct PatternMetrics { int tp=0; int fp=0; int fn=0; int tn=0; double precision=0; double recall=0; double f1=0; };
     std::map<std::string, PatternMetrics> perPattern;
+    // Pattern subsumption (see eliminateRedundantPatterns): only hot patterns run on every filename;
+    // redundant ones stay in reporting metadata and are consulted only to keep first-match attribution exact
+    std::vector<size_t> hot_patterns;        // indices into minimized_dfas, ascending
+    std::vector<size_t> redundant_patterns;  // dropped indices, ascending
+    std::vector<int> subsumed_by;            // per pattern: kept pattern whose language contains it, or -1
     unsigned int rngSeed = 311U; // reproducible sampling seed
+    // Parallel classification: dataset is split into fixed chunks, each with its own accumulator,
+    // merged in chunk order so counts, samples and detected order match a single-threaded run
+    int num_threads = 1;
+    std::unique_ptr<ThreadPool> pool; // created on first parallel pass
+    ThreadPool* getPool();
+    // Run fn(partial[c], begin, end) over dataset chunks, one accumulator per chunk
+    // (a single inline chunk when num_threads <= 1)
+    template <typename Acc, typename Fn> void forEachDatasetChunk(std::vector<Acc>& partial, Fn fn);
     
     // NEW: Helper methods for NFA to DFA conversion
     DFA subsetConstruction(const NFA& nfa);
     std::set<int> epsilonClosure(const NFA& nfa, const std::set<int>& states);
     std::set<int> move(const NFA& nfa, const std::set<int>& states, char symbol);
+    // regex → NFA → DFA → minimized DFA for a single pattern (used by policy compilation)
+    DFA buildMinimizedDFA(const std::string& regex);
     
     // NEW: Actually use DFAs for testing (non-verbose helpers kept private; public wrappers below)
     bool testFilenameWithDFAVerbose(const std::string& filename, std::string& matched_pattern);
     bool runDFAVerbose(const DFA& dfa, const std::string& input);
     bool checkAdditionalPatterns(const std::string& filename, std::string& matched_pattern);
+    // O(1) known-IOC lookup on a lowercased filename (full name, then stem before the first '.')
+    bool matchKnownIOC(const std::string& lower) const;
+    // Render testFilenameMatchesAll() indices as "[pattern k] [double_extension] ..." tags
+    std::string formatMatchReasons(const std::vector<size_t>& matches) const;
+    void buildHeuristicDFAs();
+    void compileFilenameMatcher();
+    void computeExtensionVerdicts();
+    // Pattern decided by the filename's final extension alone, or -1
+    int decidingExtension(const std::string& filename) const;
     // Tokenization discipline: current DFA is per-character; helper to expose alphabet
     std::set<char> getAlphabetUnion() const;
     void setSeed(unsigned int seed) { rngSeed = seed; }
@@ -52,6 +121,15 @@ private:
 public:
     DFAModule();
     void setCombineAllPatterns(bool on) { combineAll = on; }
+    void setThreads(int n) { num_threads = n < 1 ? 1 : n; }
+    void setDatasetStore(std::shared_ptr<DatasetStore> store) { datasets = std::move(store); }
+    // Entries per verdict cache (filenames and payloads each); 0 disables memoization
+    void setVerdictCacheCapacity(size_t entries) { filename_cache.resize(entries); content_cache.resize(entries); }
+    void printVerdictCacheStats() const;
+    // Stable across runs: changes whenever any filename/content pattern, allowlist, blocklist or
+    // IOC set changes (persistent verdicts are keyed on it)
+    uint64_t patternSetVersion() const;
+    void setAllowlistPatterns(const std::vector<std::string>& patterns) { allowlist_patterns = patterns; }
     // Clear current staged filename dataset and reset basic metrics
     void clearDataset();
     
@@ -60,12 +138,21 @@ public:
     // NEW: Stage filename entries derived from TCP trace datasets
     void loadFilenamesFromTCPJsonl(const std::string& filepath);
     void loadFilenamesFromCSVTraces(const std::string& filepath);
+    // Load an exact-name blocklist (one name per line; "*suffix" lines are suffix entries)
+    void loadBlocklist(const std::string& filepath);
+    // Load the known-IOC prefilter: a malware.csv-style file is compiled (and cached to
+    // output/ioc_filter.bin); any other path is read as a serialized filter
+    void loadIOCFilter(const std::string& path);
     void definePatterns();
     void buildNFAs();
     void convertToDFAs();
     void minimizeDFAs();
     // Hopcroft's DFA minimization (actual implementation)
     DFA hopcroftMinimize(const DFA& dfa, int& refinementSteps, std::vector<std::set<int>>& finalPartitions);
+    // Automata algebra: compile (∪ anyOf) \ (∪ noneOf) into one minimized DFA over printable ASCII
+    DFA compilePolicy(const std::vector<std::string>& anyOf, const std::vector<std::string>& noneOf);
+    // Compile-time redundancy analysis: drop patterns implied by others (or duplicates) from the hot set
+    void eliminateRedundantPatterns();
 
     // NEW: Content DFA pipeline
     void defineContentPatterns();
@@ -79,17 +166,30 @@ public:
     void generateReport();
     // Scan custom file paths using DFA modules
     void scanFiles(const std::vector<std::string>& filePaths);
+    // Walk a directory tree in parallel (num_threads workers) and stream suspicious names as found
+    void scanDirectory(const std::string& root);
     void generateScanReport(const std::vector<std::string>& filePaths, 
                            const std::vector<bool>& detected, 
-                           const std::vector<std::string>& matched_patterns);
+                           const std::vector<std::string>& matched_patterns,
+                           const std::vector<FileContentResult>& content = {});
+    // Run the content DFAs over a file's bytes (mmap for large files, pread for small ones)
+    FileContentResult scanFileContent(const std::string& path);
+    // "MALICIOUS (pattern) [mmap, N bytes]" / "CLEAN [...]" / "UNREADABLE"
+    static std::string describeContentResult(const FileContentResult& r);
     // Public non-verbose DFA run/classification
     bool runDFA(const DFA& dfa, const std::string& input);
     bool testFilenameWithDFA(const std::string& filename, std::string& matched_pattern);
     // NEW: Return all matched filename patterns (indices) for detailed reporting
     std::vector<size_t> testFilenameMatchesAll(const std::string& filename);
+    // Verdict only (no attribution): a risky extension that decides the verdict skips the automaton pass
+    bool isSuspiciousFilename(const std::string& filename);
     // NEW: DFA content scan (simple regex-derived checks). Returns true if content looks malicious.
-    bool scanContent(const std::string& content);
-    bool testContentWithDFA(const std::string& content, std::string& matched_pattern);
+    bool scanContent(std::string_view content);
+    bool testContentWithDFA(std::string_view content, std::string& matched_pattern);
+    // Streaming content scan: a scanner that accepts arbitrary chunks and carries DFA state across them
+    StreamScanner newContentStream();
+    // Scan a stream through a fixed-size buffer; stops reading once the verdict is certain
+    bool scanContentStream(std::istream& in, std::string& matched_pattern, size_t chunkSize = 64 * 1024);
     // Integrate evaluation CSVs: combined_random (type column) and malware
     // Synthesizes filenames from hashes and routes by label:
     // - combined_random.csv: type=1 -> benign, type=0 -> malicious
@@ -109,6 +209,8 @@ public:
     const DFAMetrics& getMetrics() const { return metrics; }
     const std::vector<std::string>& getPatternNames() const { return pattern_names; }
     const std::vector<std::string>& getRegexPatterns() const { return regex_patterns; }
+    const std::vector<size_t>& getHotPatterns() const { return hot_patterns; }
+    const std::vector<size_t>& getRedundantPatterns() const { return redundant_patterns; }
     const std::vector<std::string>& getContentPatternNames() const { return content_pattern_names; }
     const std::vector<std::string>& getContentRegexPatterns() const { return content_regex_patterns; }
     size_t getContentDfaCount() const;
@@ -0,0 +1,148 @@
+/**
+ * ExtensionTable.h
+ * Compile-time minimal perfect hash over known risky and benign file extensions
+ */
+
+#ifndef EXTENSIONTABLE_H
+#define EXTENSIONTABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace CS311 {
+
+enum class ExtClass : uint8_t { Risky, Benign };
+
+namespace ExtensionHash {
+
+constexpr size_t SLOTS = 32;
+constexpr size_t BUCKETS = 16;
+constexpr uint32_t SEED = 5;
+
+struct Def { const char* ext; ExtClass cls; };
+constexpr Def KNOWN[SLOTS] = {
+    {"exe", ExtClass::Risky}, {"scr", ExtClass::Risky}, {"bat", ExtClass::Risky}, {"vbs", ExtClass::Risky},
+    {"cmd", ExtClass::Risky}, {"com", ExtClass::Risky}, {"pif", ExtClass::Risky}, {"js", ExtClass::Risky},
+    {"jse", ExtClass::Risky}, {"vbe", ExtClass::Risky}, {"wsf", ExtClass::Risky}, {"hta", ExtClass::Risky},
+    {"msi", ExtClass::Risky}, {"ps1", ExtClass::Risky}, {"jar", ExtClass::Risky}, {"dll", ExtClass::Risky},
+    {"lnk", ExtClass::Risky}, {"reg", ExtClass::Risky}, {"cpl", ExtClass::Risky}, {"docm", ExtClass::Risky},
+    {"txt", ExtClass::Benign}, {"pdf", ExtClass::Benign}, {"jpg", ExtClass::Benign}, {"png", ExtClass::Benign},
+    {"gif", ExtClass::Benign}, {"doc", ExtClass::Benign}, {"docx", ExtClass::Benign}, {"xlsx", ExtClass::Benign},
+    {"csv", ExtClass::Benign}, {"mp3", ExtClass::Benign}, {"mp4", ExtClass::Benign}, {"zip", ExtClass::Benign}
+};
+
+constexpr uint32_t mix(uint32_t packed) {
+    uint32_t x = packed ^ SEED;
+    x *= 0x9E3779B1u; x ^= x >> 15;
+    x *= 0x85EBCA77u; x ^= x >> 13;
+    return x;
+}
+
+constexpr uint32_t packLiteral(const char* s) {
+    uint32_t p = 0;
+    for (int i = 0; i < 4 && s[i]; ++i) p |= (uint32_t)(unsigned char)s[i] << (8 * i);
+    return p;
+}
+
+struct Table {
+    uint8_t disp[BUCKETS] = {};
+    uint32_t key[SLOTS] = {};    // packed extension stored in each slot
+    uint8_t def[SLOTS] = {};     // index into KNOWN
+    bool ok = false;
+};
+
+// Hash-and-displace placement, largest buckets first; ok stays false if some bucket cannot be placed
+constexpr Table build() {
+    Table t{};
+    bool used[SLOTS] = {};
+    size_t bucketSize[BUCKETS] = {};
+    for (size_t k = 0; k < SLOTS; ++k) bucketSize[mix(packLiteral(KNOWN[k].ext)) & (BUCKETS - 1)]++;
+    bool placed[BUCKETS] = {};
+    for (size_t round = 0; round < BUCKETS; ++round) {
+        size_t b = BUCKETS;
+        for (size_t c = 0; c < BUCKETS; ++c) {
+            if (!placed[c] && (b == BUCKETS || bucketSize[c] > bucketSize[b])) b = c;
+        }
+        placed[b] = true;
+        bool done = bucketSize[b] == 0;
+        for (uint32_t d = 0; d < SLOTS && !done; ++d) {
+            bool taken[SLOTS] = {};
+            bool fits = true;
+            for (size_t k = 0; k < SLOTS && fits; ++k) {
+                uint32_t x = mix(packLiteral(KNOWN[k].ext));
+                if ((x & (BUCKETS - 1)) != b) continue;
+                uint32_t s = (x >> 27) ^ d;
+                if (used[s] || taken[s]) fits = false; else taken[s] = true;
+            }
+            if (!fits) continue;
+            for (size_t s = 0; s < SLOTS; ++s) if (taken[s]) used[s] = true;
+            for (size_t k = 0; k < SLOTS; ++k) {
+                uint32_t x = mix(packLiteral(KNOWN[k].ext));
+                if ((x & (BUCKETS - 1)) != b) continue;
+                uint32_t s = (x >> 27) ^ d;
+                t.key[s] = packLiteral(KNOWN[k].ext);
+                t.def[s] = (uint8_t)k;
+            }
+            t.disp[b] = (uint8_t)d;
+            done = true;
+        }
+        if (!done) return t;
+    }
+    t.ok = true;
+    return t;
+}
+
+constexpr Table TABLE = build();
+static_assert(TABLE.ok, "ExtensionHash: no perfect placement for KNOWN with this SEED; try another SEED");
+
+} // namespace ExtensionHash
+
+/**
+ * 32 extensions (up to 4 characters) hashed into exactly 32 slots with hash-and-displace:
+ * a mixed 32-bit key picks one of 16 buckets and a base slot, and each bucket stores an XOR
+ * displacement chosen so that no two keys share a slot. The displacements are searched by a
+ * constexpr builder, so the table is fixed at compile time and a static_assert rejects an
+ * extension list the seed cannot place. A lookup is: pack, mix, one displacement load, one
+ * key compare.
+ */
+class ExtensionTable {
+public:
+    static constexpr size_t SLOTS = ExtensionHash::SLOTS;
+
+    // Slot of a known extension (case-insensitive, without the dot), or -1
+    static int find(const char* ext, size_t n) {
+        using namespace ExtensionHash;
+        if (n == 0 || n > 4) return -1;
+        uint32_t p = 0;
+        for (size_t i = 0; i < n; ++i) {
+            unsigned char c = (unsigned char)ext[i];
+            if (c >= 'A' && c <= 'Z') c = (unsigned char)(c + ('a' - 'A'));
+            p |= (uint32_t)c << (8 * i);
+        }
+        uint32_t x = mix(p);
+        uint32_t s = (x >> 27) ^ TABLE.disp[x & (BUCKETS - 1)];
+        return TABLE.key[s] == p ? (int)s : -1;
+    }
+    static const char* extension(int slot) { return ExtensionHash::KNOWN[ExtensionHash::TABLE.def[slot]].ext; }
+    static ExtClass classOf(int slot) { return ExtensionHash::KNOWN[ExtensionHash::TABLE.def[slot]].cls; }
+
+    // Final extension of a name (text after the last '.'), found by scanning backwards from the end.
+    // Returns false when there is no dot or the name ends with one.
+    static bool lastExtension(const std::string& name, const char*& ext, size_t& n) {
+        const char* begin = name.data();
+        const char* end = begin + name.size();
+        for (const char* p = end; p != begin; --p) {
+            if (*(p - 1) == '.') {
+                ext = p;
+                n = (size_t)(end - p);
+                return n > 0;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace CS311
+
+#endif // EXTENSIONTABLE_H
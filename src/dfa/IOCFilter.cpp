@@ -0,0 +1,156 @@
+/**
+ * IOCFilter.cpp
+ * Split-block Bloom filter with exact fingerprint confirmation
+ */
+
+#include "IOCFilter.h"
+#include "MappedFile.h"
+#include "CSVReader.h"
+#include <algorithm>
+#include <fstream>
+#include <cctype>
+#include <cstdint>
+
+namespace CS311 {
+
+namespace {
+// Odd multipliers selecting one bit per 32-bit word of a block (as in Parquet's SBBF)
+const uint32_t BLOCK_SALT[8] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+const char FILE_MAGIC[4] = {'I', 'O', 'C', 'F'};
+const uint32_t FILE_VERSION = 1;
+} // namespace
+
+std::string IOCFilter::normalize(const std::string& key) {
+    std::string k = key;
+    std::transform(k.begin(), k.end(), k.begin(), [](unsigned char c){ return (char)std::tolower(c); });
+    return k;
+}
+
+void IOCFilter::insertHash(uint64_t h) {
+    uint64_t block = ((h >> 32) * num_blocks) >> 32;
+    uint32_t key = (uint32_t)h;
+    uint32_t* words = &blocks[block * WORDS_PER_BLOCK];
+    for (int i = 0; i < WORDS_PER_BLOCK; ++i) {
+        words[i] |= 1U << ((key * BLOCK_SALT[i]) >> 27);
+    }
+}
+
+bool IOCFilter::mayContainHash(uint64_t h) const {
+    if (num_blocks == 0) return false;
+    uint64_t block = ((h >> 32) * num_blocks) >> 32;
+    uint32_t key = (uint32_t)h;
+    const uint32_t* words = &blocks[block * WORDS_PER_BLOCK];
+    for (int i = 0; i < WORDS_PER_BLOCK; ++i) {
+        if ((words[i] & (1U << ((key * BLOCK_SALT[i]) >> 27))) == 0) return false;
+    }
+    return true;
+}
+
+void IOCFilter::build(const std::vector<std::string>& keys) {
+    num_blocks = std::max<uint64_t>(1, (uint64_t)(keys.size() * BITS_PER_KEY / (WORDS_PER_BLOCK * 32)) + 1);
+    blocks.assign(num_blocks * WORDS_PER_BLOCK, 0);
+    fingerprints.clear();
+    fingerprints.reserve(keys.size());
+    for (const auto& raw : keys) {
+        std::string k = normalize(raw);
+        insertHash(hashString64(k));
+        fingerprints.push_back(hashString64(k, FINGERPRINT_SEED));
+    }
+    std::sort(fingerprints.begin(), fingerprints.end());
+    fingerprints.erase(std::unique(fingerprints.begin(), fingerprints.end()), fingerprints.end());
+}
+
+bool IOCFilter::buildFromCSVs(const std::vector<std::string>& csvPaths) {
+    std::vector<std::string> keys;
+    for (const auto& path : csvPaths) {
+        MappedFile file;
+        if (!file.open(path)) {
+            std::cerr << "[ERROR] Could not open IOC CSV: " << path << std::endl;
+            return false;
+        }
+        CSVReader csv(file.view());
+        int hashCol = csv.next() ? csv.column("hash") : -1;
+        if (hashCol < 0) {
+            std::cerr << "[ERROR] IOC CSV has no 'hash' column: " << path << std::endl;
+            return false;
+        }
+        std::string decoded;
+        while (csv.next()) {
+            if (!csv.error().empty() || csv.fieldCount() <= (size_t)hashCol) continue;
+            std::string_view field = csv.text((size_t)hashCol, decoded);
+            if (field.empty()) continue;
+            keys.emplace_back(field);
+            // Synthesized filenames use the first 16 hex digits of the hash as their stem
+            if (field.size() > 16) keys.emplace_back(field.substr(0, 16));
+        }
+    }
+    build(keys);
+    return true;
+}
+
+bool IOCFilter::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    uint64_t nfp = fingerprints.size();
+    out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&FILE_VERSION), sizeof(FILE_VERSION));
+    out.write(reinterpret_cast<const char*>(&num_blocks), sizeof(num_blocks));
+    out.write(reinterpret_cast<const char*>(&nfp), sizeof(nfp));
+    out.write(reinterpret_cast<const char*>(blocks.data()), blocks.size() * sizeof(uint32_t));
+    out.write(reinterpret_cast<const char*>(fingerprints.data()), fingerprints.size() * sizeof(uint64_t));
+    return (bool)out;
+}
+
+bool IOCFilter::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    char magic[4] = {0};
+    uint32_t version = 0;
+    uint64_t nblocks = 0, nfp = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&nblocks), sizeof(nblocks));
+    in.read(reinterpret_cast<char*>(&nfp), sizeof(nfp));
+    if (!in || !std::equal(magic, magic + 4, FILE_MAGIC) || version != FILE_VERSION) return false;
+    // The counts come from the file: they must describe exactly the bytes that follow the header
+    // (a truncated or corrupt cache is rejected and the filter is left as it was)
+    std::streamoff header = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::streamoff end = in.tellg();
+    if (header < 0 || end < header) return false;
+    uint64_t remaining = (uint64_t)(end - header);
+    const uint64_t blockBytes = WORDS_PER_BLOCK * sizeof(uint32_t);
+    if (nblocks == 0 || nblocks > UINT32_MAX || nblocks > remaining / blockBytes) return false;
+    if (nfp != (remaining - nblocks * blockBytes) / sizeof(uint64_t) ||
+        (remaining - nblocks * blockBytes) % sizeof(uint64_t) != 0) return false;
+    in.seekg(header);
+    std::vector<uint32_t> b(nblocks * WORDS_PER_BLOCK);
+    std::vector<uint64_t> f(nfp);
+    in.read(reinterpret_cast<char*>(b.data()), b.size() * sizeof(uint32_t));
+    in.read(reinterpret_cast<char*>(f.data()), f.size() * sizeof(uint64_t));
+    if (!in || !std::is_sorted(f.begin(), f.end())) return false;
+    num_blocks = nblocks;
+    blocks.swap(b);
+    fingerprints.swap(f);
+    return true;
+}
+
+bool IOCFilter::mayContain(const std::string& key) const {
+    return mayContainHash(hashString64(normalize(key)));
+}
+
+bool IOCFilter::contains(const std::string& key) const {
+    if (num_blocks == 0) return false;
+    probes.fetch_add(1, std::memory_order_relaxed);
+    std::string k = normalize(key);
+    if (!mayContainHash(hashString64(k))) return false;
+    filter_passes.fetch_add(1, std::memory_order_relaxed);
+    bool hit = std::binary_search(fingerprints.begin(), fingerprints.end(), hashString64(k, FINGERPRINT_SEED));
+    if (hit) confirmed.fetch_add(1, std::memory_order_relaxed);
+    return hit;
+}
+
+} // namespace CS311
@@ -0,0 +1,76 @@
+/**
+ * IOCFilter.h
+ * Probabilistic prefilter for known-bad hashes and names (split-block Bloom filter)
+ */
+
+#ifndef IOCFILTER_H
+#define IOCFILTER_H
+
+#include "Utils.h"
+#include <string>
+#include <vector>
+#include <atomic>
+
+namespace CS311 {
+
+/**
+ * Split-block Bloom filter: each key touches exactly one 256-bit block (8 x 32-bit words,
+ * one bit per word), so a probe costs a single cache line. Positive probes are confirmed
+ * against a sorted array of independent 64-bit fingerprints, so reported hits are exact
+ * up to a 2^-64 fingerprint collision.
+ *
+ * Keys are lowercased before hashing. Probes are const and safe for concurrent readers.
+ */
+class IOCFilter {
+private:
+    static constexpr int WORDS_PER_BLOCK = 8;
+    static constexpr double BITS_PER_KEY = 12.0; // ~0.5% false positive rate before confirmation
+    static constexpr uint64_t FINGERPRINT_SEED = 0x1c0f11e7ULL;
+
+    std::vector<uint32_t> blocks;          // num_blocks * WORDS_PER_BLOCK
+    std::vector<uint64_t> fingerprints;    // sorted, unique: exact secondary structure
+    uint64_t num_blocks = 0;
+
+    // Probe statistics (relaxed atomics: reporting only)
+    mutable std::atomic<uint64_t> probes{0};
+    mutable std::atomic<uint64_t> filter_passes{0};
+    mutable std::atomic<uint64_t> confirmed{0};
+
+    void insertHash(uint64_t h);
+    bool mayContainHash(uint64_t h) const;
+    static std::string normalize(const std::string& key);
+
+public:
+    IOCFilter() = default;
+    IOCFilter(const IOCFilter&) = delete;
+    IOCFilter& operator=(const IOCFilter&) = delete;
+
+    // Build from a list of keys (replaces current contents)
+    void build(const std::vector<std::string>& keys);
+    // Build from malware.csv-style files (header with a "hash" column). Each hash contributes the
+    // full hash and its 16-character prefix (the stem of synthesized filenames).
+    bool buildFromCSVs(const std::vector<std::string>& csvPaths);
+
+    // Binary serialization: "IOCF" magic, version, block count, fingerprint count, payload
+    bool save(const std::string& path) const;
+    // false (filter unchanged) when the file is missing, truncated or inconsistent
+    bool load(const std::string& path);
+
+    // Stage 1 only (may report false positives)
+    bool mayContain(const std::string& key) const;
+    // Stage 1 + exact confirmation
+    bool contains(const std::string& key) const;
+
+    bool empty() const { return fingerprints.empty(); }
+    size_t size() const { return fingerprints.size(); }
+    // Hash of the key set (order-independent: fingerprints are kept sorted)
+    uint64_t digest() const { return hashBytes64(fingerprints.data(), fingerprints.size() * sizeof(uint64_t)); }
+    size_t memoryBytes() const { return blocks.size() * sizeof(uint32_t) + fingerprints.size() * sizeof(uint64_t); }
+    uint64_t getProbes() const { return probes.load(std::memory_order_relaxed); }
+    uint64_t getFilterPasses() const { return filter_passes.load(std::memory_order_relaxed); }
+    uint64_t getConfirmed() const { return confirmed.load(std::memory_order_relaxed); }
+};
+
+} // namespace CS311
+
+#endif // IOCFILTER_H
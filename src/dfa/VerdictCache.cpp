@@ -0,0 +1,127 @@
+/**
+ * VerdictCache.cpp
+ * Sharded, bounded memo of classification verdicts keyed by 64-bit input hashes
+ */
+
+#include "VerdictCache.h"
+#include <mutex>
+
+namespace CS311 {
+
+VerdictCache::VerdictCache(size_t capacity, size_t shardCount) {
+    for (size_t i = 0; i < (shardCount ? shardCount : 1); ++i) shards.push_back(std::make_unique<Shard>());
+    resize(capacity);
+}
+
+void VerdictCache::resize(size_t capacity) {
+    total_capacity = capacity;
+    size_t per = capacity ? (capacity + shards.size() - 1) / shards.size() : 0;
+    for (auto& s : shards) {
+        std::unique_lock<std::shared_mutex> lock(s->m);
+        s->capacity = per;
+        s->slots.reset(per ? new Slot[per] : nullptr);
+        s->index.clear();
+        s->index.reserve(per);
+        s->used = 0;
+        s->hand = 0;
+    }
+}
+
+void VerdictCache::clear() {
+    for (auto& s : shards) {
+        std::unique_lock<std::shared_mutex> lock(s->m);
+        for (size_t i = 0; i < s->capacity; ++i) s->slots[i].used = false;
+        s->index.clear();
+        s->used = 0;
+        s->hand = 0;
+        s->hits = 0;
+        s->misses = 0;
+        s->evictions = 0;
+    }
+}
+
+bool VerdictCache::lookup(uint64_t key, int32_t& value) const {
+    if (!enabled()) return false;
+    Shard& s = shardFor(key);
+    {
+        std::shared_lock<std::shared_mutex> lock(s.m);
+        auto it = s.index.find(key);
+        if (it != s.index.end()) {
+            const Slot& slot = s.slots[it->second];
+            slot.referenced.store(1, std::memory_order_relaxed);
+            value = slot.value;
+            s.hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    s.misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void VerdictCache::insert(uint64_t key, int32_t value) {
+    if (!enabled()) return;
+    Shard& s = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(s.m);
+    auto it = s.index.find(key);
+    if (it != s.index.end()) { // another thread computed the same verdict first
+        s.slots[it->second].value = value;
+        return;
+    }
+    size_t victim;
+    if (s.used < s.capacity) {
+        victim = s.used++;
+    } else {
+        // CLOCK sweep: give referenced slots a second chance
+        while (s.slots[s.hand].referenced.load(std::memory_order_relaxed)) {
+            s.slots[s.hand].referenced.store(0, std::memory_order_relaxed);
+            s.hand = (s.hand + 1) % s.capacity;
+        }
+        victim = s.hand;
+        s.hand = (s.hand + 1) % s.capacity;
+        s.index.erase(s.slots[victim].key);
+        s.evictions++;
+    }
+    Slot& slot = s.slots[victim];
+    slot.key = key;
+    slot.value = value;
+    slot.used = true;
+    slot.referenced.store(0, std::memory_order_relaxed);
+    s.index.emplace(key, (uint32_t)victim);
+}
+
+uint64_t VerdictCache::hits() const {
+    uint64_t n = 0;
+    for (const auto& s : shards) n += s->hits.load(std::memory_order_relaxed);
+    return n;
+}
+
+uint64_t VerdictCache::misses() const {
+    uint64_t n = 0;
+    for (const auto& s : shards) n += s->misses.load(std::memory_order_relaxed);
+    return n;
+}
+
+uint64_t VerdictCache::evictions() const {
+    uint64_t n = 0;
+    for (const auto& s : shards) {
+        std::shared_lock<std::shared_mutex> lock(s->m);
+        n += s->evictions;
+    }
+    return n;
+}
+
+double VerdictCache::hitRate() const {
+    uint64_t h = hits(), total = h + misses();
+    return total ? 100.0 * (double)h / (double)total : 0.0;
+}
+
+size_t VerdictCache::size() const {
+    size_t n = 0;
+    for (const auto& s : shards) {
+        std::shared_lock<std::shared_mutex> lock(s->m);
+        n += s->used;
+    }
+    return n;
+}
+
+} // namespace CS311
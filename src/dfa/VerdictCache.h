@@ -0,0 +1,79 @@
+/**
+ * VerdictCache.h
+ * Sharded, bounded memo of classification verdicts keyed by 64-bit input hashes
+ */
+
+#ifndef VERDICTCACHE_H
+#define VERDICTCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * Fixed-capacity map from a 64-bit key (hash of the input, seeded with the pattern-set
+ * version) to a small integer verdict. The key space is split into shards, each with its own
+ * reader/writer lock, so lookups from many threads proceed in parallel and inserts only block
+ * one shard. Eviction is CLOCK (second chance): a hit sets the slot's reference bit without
+ * taking the write lock; on insert into a full shard the hand clears reference bits until it
+ * finds a slot that was not used since the last sweep.
+ *
+ * Keys are not verified against the original input: two inputs whose 64-bit hashes collide
+ * share a verdict, which for a few million distinct inputs is a ~1e-7 event.
+ */
+class VerdictCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+    static constexpr size_t DEFAULT_SHARDS = 16;
+
+    explicit VerdictCache(size_t capacity = DEFAULT_CAPACITY, size_t shards = DEFAULT_SHARDS);
+
+    // capacity 0 disables the cache (lookups miss without counting, inserts are dropped)
+    void resize(size_t capacity);
+    void clear();
+    bool enabled() const { return total_capacity > 0; }
+
+    bool lookup(uint64_t key, int32_t& value) const;
+    void insert(uint64_t key, int32_t value);
+
+    uint64_t hits() const;
+    uint64_t misses() const;
+    uint64_t evictions() const;
+    double hitRate() const;
+    size_t size() const;
+    size_t capacity() const { return total_capacity; }
+
+private:
+    struct Slot {
+        uint64_t key = 0;
+        int32_t value = 0;
+        bool used = false;
+        mutable std::atomic<uint8_t> referenced{0};
+    };
+    struct alignas(64) Shard {
+        mutable std::shared_mutex m;
+        std::unordered_map<uint64_t, uint32_t> index; // key -> slot
+        std::unique_ptr<Slot[]> slots;
+        size_t capacity = 0;
+        size_t used = 0;
+        size_t hand = 0;
+        mutable std::atomic<uint64_t> hits{0};
+        mutable std::atomic<uint64_t> misses{0};
+        uint64_t evictions = 0;
+    };
+    std::vector<std::unique_ptr<Shard>> shards;
+    size_t total_capacity = 0;
+
+    // High bits pick the shard; the per-shard hash map uses the whole key
+    Shard& shardFor(uint64_t key) const { return *shards[(size_t)(key >> 40) % shards.size()]; }
+};
+
+} // namespace CS311
+
+#endif // VERDICTCACHE_H
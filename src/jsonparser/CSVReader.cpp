@@ -0,0 +1,174 @@
+/**
+ * CSVReader.cpp
+ * Zero-copy RFC 4180 CSV reader shared by every CSV consumer
+ */
+
+#include "CSVReader.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CS311_CSV_SSE2 1
+#endif
+
+namespace CS311 {
+
+namespace {
+
+// First ',' or '\n' in [p, end), or end
+inline const char* findDelimiter(const char* p, const char* end) {
+#ifdef CS311_CSV_SSE2
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, newline)));
+        if (mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long bit;
+            _BitScanForward(&bit, (unsigned long)mask);
+            return p + bit;
+#else
+            return p + __builtin_ctz((unsigned)mask);
+#endif
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && *p != ',' && *p != '\n') ++p;
+    return p;
+}
+
+inline size_t countNewlines(const char* p, const char* end) {
+    return (size_t)std::count(p, end, '\n');
+}
+
+} // namespace
+
+bool CSVReader::next() {
+    fields.clear();
+    err.clear();
+    open_quote = false;
+    ended_by_newline = false;
+    if (pos >= input.size()) return false;
+
+    const char* data = input.data();
+    const char* end = data + input.size();
+    const char* p = data + pos;
+    record_begin = pos;
+    record_line = lines + 1;
+
+    while (true) {
+        Field f;
+        if (p < end && *p == '"') {
+            f.quoted = true;
+            const char* content = p + 1;
+            const char* q = content;
+            while (true) {
+                q = static_cast<const char*>(std::memchr(q, '"', (size_t)(end - q)));
+                if (!q) break;
+                if (q + 1 < end && q[1] == '"') { f.escaped = true; q += 2; continue; }
+                break;
+            }
+            if (!q) {
+                open_quote = true;
+                err = "unterminated quoted field";
+                lines += countNewlines(content, end);
+                pos = input.size();
+                return true;
+            }
+            lines += countNewlines(content, q);
+            f.raw = std::string_view(content, (size_t)(q - content));
+            p = q + 1;
+            bool crlf = p < end && *p == '\r' && (p + 1 == end || p[1] == '\n');
+            if (p < end && *p != ',' && *p != '\n' && !crlf) {
+                // Resynchronize at the next line break; the record is reported and skipped
+                err = "unexpected character after closing quote";
+                const char* nl = static_cast<const char*>(std::memchr(p, '\n', (size_t)(end - p)));
+                p = nl ? nl : end;
+            }
+        } else {
+            const char* q = findDelimiter(p, end);
+            const char* stop = q;
+            if ((q == end || *q == '\n') && stop > p && stop[-1] == '\r') --stop;
+            f.raw = std::string_view(p, (size_t)(stop - p));
+            p = q;
+        }
+        fields.push_back(f);
+
+        if (p < end && *p == ',') { ++p; continue; }
+        if (p < end && *p == '\r') ++p;
+        if (p < end && *p == '\n') {
+            ++p;
+            ++lines;
+            ended_by_newline = true;
+        }
+        break;
+    }
+    pos = (size_t)(p - data);
+    return true;
+}
+
+std::string_view CSVReader::text(size_t i, std::string& out) const {
+    const Field& f = fields[i];
+    if (!f.escaped) return f.raw;
+    out.resize(f.raw.size());
+    out.resize(decode(i, &out[0]));
+    return out;
+}
+
+size_t CSVReader::decode(size_t i, char* out) const {
+    const Field& f = fields[i];
+    if (!f.escaped) {
+        std::memcpy(out, f.raw.data(), f.raw.size());
+        return f.raw.size();
+    }
+    size_t n = 0;
+    for (size_t k = 0; k < f.raw.size(); ++k) {
+        out[n++] = f.raw[k];
+        if (f.raw[k] == '"' && k + 1 < f.raw.size() && f.raw[k + 1] == '"') ++k;
+    }
+    return n;
+}
+
+int CSVReader::column(std::string_view name) const {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        std::string_view v = fields[i].raw;
+        if (v.size() == name.size() && std::equal(v.begin(), v.end(), name.begin(), [](char a, char b) {
+                return std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
+            })) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+size_t CSVReader::recordBoundary(std::string_view text, size_t from, size_t& scanned, bool& quoted) {
+    const char* data = text.data();
+    size_t n = text.size();
+    // Quote state at `from`: a doubled quote toggles twice, so parity alone decides it
+    for (const char* p = data + scanned, *end = data + std::max(scanned, from);
+         (p = static_cast<const char*>(std::memchr(p, '"', (size_t)(end - p)))) != nullptr; ++p) {
+        quoted = !quoted;
+    }
+    size_t i = std::max(scanned, from);
+    while (i < n) {
+        char c = data[i++];
+        if (c == '"') quoted = !quoted;
+        else if (c == '\n' && !quoted) break;
+    }
+    scanned = i;
+    return i;
+}
+
+bool CSVReader::simdEnabled() {
+#ifdef CS311_CSV_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace CS311
@@ -0,0 +1,94 @@
+/**
+ * CSVReader.h
+ * Zero-copy RFC 4180 CSV reader shared by every CSV consumer
+ */
+
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * Walks a CSV text (typically a mapped file) one record at a time. Fields are views into the
+ * text: a quoted field's view is its content between the quotes, and only fields containing
+ * doubled quotes ("") need decoding, via text()/decode(). RFC 4180 rules apply: quoted fields
+ * may hold commas, quotes and line breaks, records end at LF or CRLF, "a," has two fields.
+ * Quotes inside an unquoted field are kept as literal characters.
+ *
+ * The scan for the next ',' or '\n' in unquoted fields compares 16 bytes at a time with SSE2
+ * where available. The field vector is reused across records, so a steady-state next() does
+ * not allocate. Malformed records (junk after a closing quote, a quote never closed) are
+ * reported through error() and skipped by the caller; reading continues with the next record.
+ */
+class CSVReader {
+public:
+    explicit CSVReader(std::string_view text) : input(text) {}
+
+    // Advance to the next record; false at the end of the text
+    bool next();
+
+    size_t fieldCount() const { return fields.size(); }
+    // Field content as it appears in the text (quotes stripped, "" not yet collapsed)
+    std::string_view raw(size_t i) const { return fields[i].raw; }
+    // True if the field has doubled quotes and raw() differs from the decoded value
+    bool escaped(size_t i) const { return fields[i].escaped; }
+    // Decoded value: a view when no decoding is needed, else a copy in `out`
+    std::string_view text(size_t i, std::string& out) const;
+    // Decode into `out` (needs raw(i).size() bytes; decoding never grows) and return the length
+    size_t decode(size_t i, char* out) const;
+
+    // A single empty field (empty line)
+    bool blank() const { return fields.size() == 1 && fields[0].raw.empty() && !fields[0].quoted; }
+    // Empty unless the current record is malformed
+    const std::string& error() const { return err; }
+    // The text ended inside a quoted field (the record is incomplete)
+    bool openQuote() const { return open_quote; }
+    // The record was ended by a line break (false only for the last record of the text)
+    bool terminated() const { return ended_by_newline; }
+
+    // Byte offset of the current record and of the next one
+    size_t recordBegin() const { return record_begin; }
+    size_t position() const { return pos; }
+    // 1-based line of the current record's first character; line breaks consumed so far
+    size_t line() const { return record_line; }
+    size_t linesConsumed() const { return lines; }
+
+    // Index of the column whose current field equals `name` (ASCII case-insensitive), or -1;
+    // meant for the header record
+    int column(std::string_view name) const;
+
+    // Offset just past the first line break at or after `from` that is outside quotes, judged
+    // by quote parity from `scanned` (updated, with `quoted`, so calls with increasing `from`
+    // scan the text once). Exact for RFC 4180 input; stray quotes in unquoted fields can
+    // mislead it, which callers detect through openQuote() on the preceding part.
+    static size_t recordBoundary(std::string_view text, size_t from, size_t& scanned, bool& quoted);
+
+    // True when the SIMD delimiter scan is compiled in (false: portable byte loop)
+    static bool simdEnabled();
+
+private:
+    struct Field {
+        std::string_view raw;
+        bool quoted = false;
+        bool escaped = false;
+    };
+
+    std::string_view input;
+    size_t pos = 0;
+    size_t record_begin = 0;
+    size_t record_line = 1;
+    size_t lines = 0;
+    bool ended_by_newline = false;
+    bool open_quote = false;
+    std::vector<Field> fields;
+    std::string err;
+};
+
+} // namespace CS311
+
+#endif // CSVREADER_H
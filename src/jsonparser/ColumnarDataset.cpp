@@ -0,0 +1,323 @@
+/**
+ * ColumnarDataset.cpp
+ * Compact columnar binary form of a trace dataset (.tcol), written once and mapped on re-runs
+ */
+
+#include "ColumnarDataset.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+namespace CS311 {
+
+namespace {
+const char MAGIC[4] = { 'T', 'C', 'O', 'L' };
+const size_t MAX_TOKENS = 256;
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint32_t records;
+    uint32_t strings;
+    uint64_t pool_bytes;
+    uint64_t packets;
+    uint32_t description_values;
+    uint32_t category_values;
+    uint32_t token_values;
+    uint8_t description_width;
+    uint8_t category_width;
+    uint16_t reserved;
+};
+static_assert(sizeof(Header) == 64, "ColumnarDataset header must stay 64 bytes (on-disk format)");
+
+size_t align8(size_t n) { return (n + 7) & ~(size_t)7; }
+
+// Byte offset of every section, derived from the header counts alone
+struct Layout {
+    size_t string_offsets, pool, trace_ids, contents;
+    size_t description_dict, description_codes, category_dict, category_codes;
+    size_t token_dict, sequence_offsets, tokens, valid_bits, total;
+};
+
+Layout layoutFor(const Header& h) {
+    Layout l;
+    size_t at = sizeof(Header);
+    auto section = [&at](size_t bytes) { size_t start = at; at = align8(at + bytes); return start; };
+    l.string_offsets = section(((size_t)h.strings + 1) * sizeof(uint64_t));
+    l.pool = section((size_t)h.pool_bytes);
+    l.trace_ids = section((size_t)h.records * sizeof(uint32_t));
+    l.contents = section((size_t)h.records * sizeof(uint32_t));
+    l.description_dict = section((size_t)h.description_values * sizeof(uint32_t));
+    l.description_codes = section((size_t)h.records * h.description_width);
+    l.category_dict = section((size_t)h.category_values * sizeof(uint32_t));
+    l.category_codes = section((size_t)h.records * h.category_width);
+    l.token_dict = section((size_t)h.token_values * sizeof(uint32_t));
+    l.sequence_offsets = section(((size_t)h.records + 1) * sizeof(uint64_t));
+    l.tokens = section((size_t)h.packets);
+    l.valid_bits = section(((size_t)h.records + 63) / 64 * sizeof(uint64_t));
+    l.total = at;
+    return l;
+}
+
+uint8_t codeWidth(size_t values) {
+    if (values <= 0x100) return 1;
+    if (values <= 0x10000) return 2;
+    return 4;
+}
+
+template <typename T>
+T load(const char* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+uint32_t loadCode(const char* codes, size_t i, uint8_t width) {
+    switch (width) {
+    case 1: return (uint8_t)codes[i];
+    case 2: return load<uint16_t>(codes + 2 * i);
+    default: return load<uint32_t>(codes + 4 * i);
+    }
+}
+
+// Distinct values of one column, in first-seen order
+class Dictionary {
+public:
+    uint32_t code(std::string_view s) {
+        auto ins = index.emplace(s, (uint32_t)values.size());
+        if (ins.second) values.push_back(s);
+        return ins.first->second;
+    }
+    const std::vector<std::string_view>& items() const { return values; }
+private:
+    std::unordered_map<std::string_view, uint32_t> index;
+    std::vector<std::string_view> values;
+};
+
+class SectionWriter {
+public:
+    explicit SectionWriter(std::ofstream& o) : out(o) {}
+    void put(const void* data, size_t n) {
+        out.write(static_cast<const char*>(data), (std::streamsize)n);
+        written += n;
+    }
+    template <typename T>
+    void putArray(const std::vector<T>& v) { put(v.data(), v.size() * sizeof(T)); }
+    void pad() {
+        static const char zeros[8] = {};
+        put(zeros, align8(written) - written);
+    }
+    void putCodes(const std::vector<uint32_t>& codes, uint8_t width) {
+        std::vector<char> packed(codes.size() * width);
+        for (size_t i = 0; i < codes.size(); ++i) {
+            if (width == 1) packed[i] = (char)(uint8_t)codes[i];
+            else if (width == 2) { uint16_t v = (uint16_t)codes[i]; std::memcpy(&packed[2 * i], &v, 2); }
+            else std::memcpy(&packed[4 * i], &codes[i], 4);
+        }
+        putArray(packed);
+        pad();
+    }
+    size_t size() const { return written; }
+private:
+    std::ofstream& out;
+    size_t written = 0;
+};
+} // namespace
+
+bool ColumnarDataset::stampOf(const std::string& path, SourceStamp& stamp) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    auto time = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    stamp.size = (uint64_t)size;
+    stamp.mtime = (int64_t)time.time_since_epoch().count();
+    return true;
+}
+
+bool ColumnarDataset::write(const TraceViewSet& set, const std::string& path, const SourceStamp& source, std::string& error) {
+    const auto& records = set.records();
+    Dictionary strings, descriptions, categories, tokens;
+    std::vector<uint32_t> trace_ids, contents, description_codes, category_codes;
+    std::vector<uint64_t> sequence_offsets;
+    std::vector<uint8_t> packet_tokens;
+    std::vector<uint64_t> valid_bits((records.size() + 63) / 64, 0);
+    trace_ids.reserve(records.size());
+    contents.reserve(records.size());
+    description_codes.reserve(records.size());
+    category_codes.reserve(records.size());
+    sequence_offsets.reserve(records.size() + 1);
+    sequence_offsets.push_back(0);
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        const TraceView& t = records[i];
+        trace_ids.push_back(strings.code(t.trace_id));
+        contents.push_back(strings.code(t.content));
+        description_codes.push_back(descriptions.code(t.description));
+        category_codes.push_back(categories.code(t.category));
+        for (const auto& packet : t.sequence) {
+            uint32_t token = tokens.code(packet);
+            if (token >= MAX_TOKENS) {
+                error = "more than 256 distinct packet tokens";
+                return false;
+            }
+            packet_tokens.push_back((uint8_t)token);
+        }
+        sequence_offsets.push_back(packet_tokens.size());
+        if (t.valid) valid_bits[i / 64] |= 1ULL << (i % 64);
+    }
+    // Dictionary values live in the same string pool as the plain columns
+    auto poolIndices = [&strings](const Dictionary& d) {
+        std::vector<uint32_t> idx;
+        idx.reserve(d.items().size());
+        for (const auto& s : d.items()) idx.push_back(strings.code(s));
+        return idx;
+    };
+    std::vector<uint32_t> description_dict = poolIndices(descriptions);
+    std::vector<uint32_t> category_dict = poolIndices(categories);
+    std::vector<uint32_t> token_dict = poolIndices(tokens);
+    if (strings.items().size() > 0xFFFFFFFFULL || records.size() > 0xFFFFFFFFULL) {
+        error = "dataset too large for the columnar format";
+        return false;
+    }
+
+    Header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = FORMAT_VERSION;
+    h.source_size = source.size;
+    h.source_mtime = source.mtime;
+    h.records = (uint32_t)records.size();
+    h.strings = (uint32_t)strings.items().size();
+    std::vector<uint64_t> string_offsets;
+    string_offsets.reserve(strings.items().size() + 1);
+    string_offsets.push_back(0);
+    for (const auto& s : strings.items()) string_offsets.push_back(string_offsets.back() + s.size());
+    h.pool_bytes = string_offsets.back();
+    h.packets = packet_tokens.size();
+    h.description_values = (uint32_t)description_dict.size();
+    h.category_values = (uint32_t)category_dict.size();
+    h.token_values = (uint32_t)token_dict.size();
+    h.description_width = codeWidth(description_dict.size());
+    h.category_width = codeWidth(category_dict.size());
+
+    std::string tmp = path + ".tmp";
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        error = "cannot create " + tmp;
+        return false;
+    }
+    SectionWriter w(out);
+    w.put(&h, sizeof(h));
+    w.putArray(string_offsets); w.pad();
+    for (const auto& s : strings.items()) w.put(s.data(), s.size());
+    w.pad();
+    w.putArray(trace_ids); w.pad();
+    w.putArray(contents); w.pad();
+    w.putArray(description_dict); w.pad();
+    w.putCodes(description_codes, h.description_width);
+    w.putArray(category_dict); w.pad();
+    w.putCodes(category_codes, h.category_width);
+    w.putArray(token_dict); w.pad();
+    w.putArray(sequence_offsets); w.pad();
+    w.putArray(packet_tokens); w.pad();
+    w.putArray(valid_bits); w.pad();
+    out.close();
+    if (!out || w.size() != layoutFor(h).total) {
+        std::remove(tmp.c_str());
+        error = "write failed: " + tmp;
+        return false;
+    }
+    // One-step replace: readers see the old file or the new one, never a missing or partial file
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::remove(tmp.c_str());
+        error = "cannot rename " + tmp + " to " + path;
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<TraceViewSet> ColumnarDataset::read(const std::string& path, const SourceStamp* expected) {
+    auto set = std::make_shared<TraceViewSet>();
+    MappedFile& file = set->file;
+    if (!file.open(path)) return nullptr;
+    const char* base = file.data();
+    if (file.size() < sizeof(Header)) return nullptr;
+    Header h;
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != FORMAT_VERSION) return nullptr;
+    if (expected && !(SourceStamp{ h.source_size, h.source_mtime } == *expected)) return nullptr;
+    auto widthOk = [](uint8_t w) { return w == 1 || w == 2 || w == 4; };
+    if (!widthOk(h.description_width) || !widthOk(h.category_width) || h.token_values > MAX_TOKENS) return nullptr;
+    if (h.pool_bytes > file.size() || h.packets > file.size()) return nullptr; // keeps layoutFor from wrapping
+    Layout l = layoutFor(h);
+    if (l.total != file.size()) return nullptr;
+
+    // String table: offsets must be monotonic and inside the pool
+    std::vector<std::string_view> strings(h.strings);
+    const char* pool = base + l.pool;
+    uint64_t prev = load<uint64_t>(base + l.string_offsets);
+    if (prev != 0) return nullptr;
+    for (uint32_t i = 0; i < h.strings; ++i) {
+        uint64_t next = load<uint64_t>(base + l.string_offsets + (i + 1) * sizeof(uint64_t));
+        if (next < prev || next > h.pool_bytes) return nullptr;
+        strings[i] = std::string_view(pool + prev, (size_t)(next - prev));
+        prev = next;
+    }
+    auto dictionary = [&](size_t at, uint32_t count, std::vector<std::string_view>& out) {
+        out.resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t s = load<uint32_t>(base + at + i * sizeof(uint32_t));
+            if (s >= h.strings) return false;
+            out[i] = strings[s];
+        }
+        return true;
+    };
+    std::vector<std::string_view> descriptions, categories, tokens;
+    if (!dictionary(l.description_dict, h.description_values, descriptions) ||
+        !dictionary(l.category_dict, h.category_values, categories) ||
+        !dictionary(l.token_dict, h.token_values, tokens)) return nullptr;
+
+    // The token dictionary is interned once; each packet is then two table loads
+    std::vector<PacketToken> kinds(tokens.size());
+    for (size_t k = 0; k < tokens.size(); ++k) kinds[k] = packetToken(tokens[k]);
+    set->packets.resize((size_t)h.packets);
+    set->tokens.resize((size_t)h.packets);
+    const uint8_t* packet_tokens = reinterpret_cast<const uint8_t*>(base + l.tokens);
+    for (uint64_t p = 0; p < h.packets; ++p) {
+        if (packet_tokens[p] >= h.token_values) return nullptr;
+        set->packets[(size_t)p] = tokens[packet_tokens[p]];
+        set->tokens[(size_t)p] = kinds[packet_tokens[p]];
+    }
+
+    set->views.resize(h.records);
+    uint64_t seq_begin = load<uint64_t>(base + l.sequence_offsets);
+    if (seq_begin != 0) return nullptr;
+    for (uint32_t i = 0; i < h.records; ++i) {
+        TraceView& t = set->views[i];
+        uint32_t id = load<uint32_t>(base + l.trace_ids + i * sizeof(uint32_t));
+        uint32_t content = load<uint32_t>(base + l.contents + i * sizeof(uint32_t));
+        uint32_t description = loadCode(base + l.description_codes, i, h.description_width);
+        uint32_t category = loadCode(base + l.category_codes, i, h.category_width);
+        uint64_t seq_end = load<uint64_t>(base + l.sequence_offsets + (i + 1) * sizeof(uint64_t));
+        if (id >= h.strings || content >= h.strings || description >= h.description_values ||
+            category >= h.category_values || seq_end < seq_begin || seq_end > h.packets) return nullptr;
+        t.trace_id = strings[id];
+        t.content = strings[content];
+        t.description = descriptions[description];
+        t.category = categories[category];
+        t.sequence = PacketRange(set->packets.data() + seq_begin, set->packets.data() + seq_end, set->tokens.data() + seq_begin);
+        t.valid = (load<uint64_t>(base + l.valid_bits + (i / 64) * sizeof(uint64_t)) >> (i % 64)) & 1;
+        seq_begin = seq_end;
+    }
+    return set;
+}
+
+} // namespace CS311
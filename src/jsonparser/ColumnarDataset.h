@@ -0,0 +1,52 @@
+/**
+ * ColumnarDataset.h
+ * Compact columnar binary form of a trace dataset (.tcol), written once and mapped on re-runs
+ */
+
+#ifndef COLUMNARDATASET_H
+#define COLUMNARDATASET_H
+
+#include "TraceViewSet.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace CS311 {
+
+/**
+ * Layout (host byte order, every section 8-byte aligned):
+ *   Header (64 bytes)       magic "TCOL", format version, counts, stamp of the source file
+ *   string table            (strings + 1) uint64 offsets, then the pool bytes. Every distinct
+ *                           string of the dataset is stored once.
+ *   trace_id, content       uint32 string index per record
+ *   description, category   dictionary-encoded: uint32 string index per distinct value, then
+ *                           one 1/2/4-byte code per record (width picked from the cardinality)
+ *   sequence                uint32 string index per distinct packet token (at most 256),
+ *                           (records + 1) uint64 offsets, then one uint8 token per packet
+ *   valid                   bitmap, one bit per record
+ *
+ * read() maps the file and returns a TraceViewSet whose views point into the string pool, so
+ * loading costs the record and packet arrays and nothing per string. Every index and offset
+ * is bounds-checked first; a truncated, foreign or stale file is rejected (nullptr).
+ */
+class ColumnarDataset {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    // Size and modification time of the file a dataset was converted from (0/0: unknown)
+    struct SourceStamp {
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        bool operator==(const SourceStamp& o) const { return size == o.size && mtime == o.mtime; }
+    };
+    static bool stampOf(const std::string& path, SourceStamp& stamp);
+
+    // Write `set` to `path` (via a temporary file); false with `error` set on failure
+    static bool write(const TraceViewSet& set, const std::string& path, const SourceStamp& source, std::string& error);
+    // Map `path`; with `expected`, a file converted from a different source version is refused
+    static std::shared_ptr<TraceViewSet> read(const std::string& path, const SourceStamp* expected = nullptr);
+};
+
+} // namespace CS311
+
+#endif // COLUMNARDATASET_H
@@ -0,0 +1,121 @@
+/**
+ * DatasetStore.cpp
+ * Parse-once cache of trace datasets shared by the DFA, content and PDA stages
+ */
+
+#include "DatasetStore.h"
+#include "JSONParser.h"
+#include "ColumnarDataset.h"
+#include <algorithm>
+#include <cctype>
+
+namespace CS311 {
+
+namespace {
+bool endsWith(const std::string& s, const std::string& suf) {
+    if (s.size() < suf.size()) return false;
+    return std::equal(s.end() - suf.size(), s.end(), suf.begin(), suf.end(),
+                      [](char a, char b) { return std::tolower((unsigned char)a) == std::tolower((unsigned char)b); });
+}
+} // namespace
+
+std::shared_ptr<TraceViewSet> DatasetStore::parseSource(const std::string& path) {
+    if (num_threads > 1 && !pool) pool = std::make_unique<ThreadPool>((size_t)num_threads);
+    ThreadPool* workers = num_threads > 1 ? pool.get() : nullptr;
+    return endsWith(path, ".csv") ? JSONParser::mapTCPDatasetCSV(path, workers) : JSONParser::mapTCPDataset(path, workers);
+}
+
+DatasetStore::Views DatasetStore::viewsLocked(const std::string& path) {
+    auto it = loaded.find(path);
+    if (it != loaded.end()) return it->second;
+
+    // Parsing under the lock: concurrent first requests for a path wait instead of parsing twice
+    std::shared_ptr<TraceViewSet> v;
+    if (endsWith(path, ".tcol")) {
+        std::cout << "[INFO] Loading TCP trace dataset (columnar): " << path << std::endl;
+        v = ColumnarDataset::read(path);
+        if (v) {
+            JSONParser::printTraceSummary(*v, " (columnar)");
+        } else {
+            std::cerr << "[ERROR] Not a readable columnar dataset: " << path << std::endl;
+            v = std::make_shared<TraceViewSet>();
+        }
+    } else {
+        ColumnarDataset::SourceStamp stamp;
+        std::string sidecar = path + ".tcol";
+        bool cached = columnar_cache && ColumnarDataset::stampOf(path, stamp);
+        if (cached && (v = ColumnarDataset::read(sidecar, &stamp))) {
+            std::cout << "[INFO] Loading TCP trace dataset (columnar cache): " << sidecar << std::endl;
+            JSONParser::printTraceSummary(*v, " (columnar)");
+        } else {
+            v = parseSource(path);
+            std::string error;
+            if (cached && v->size() > 0) {
+                if (ColumnarDataset::write(*v, sidecar, stamp, error)) {
+                    std::cout << "[INFO] Wrote columnar cache: " << sidecar << std::endl;
+                } else {
+                    std::cerr << "[WARN] Could not write columnar cache " << sidecar << ": " << error << std::endl;
+                }
+            }
+        }
+    }
+    loaded.emplace(path, v);
+    return v;
+}
+
+DatasetStore::Views DatasetStore::views(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m);
+    request_count++;
+    return viewsLocked(path);
+}
+
+DatasetStore::Traces DatasetStore::traces(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m);
+    request_count++;
+    auto it = materialized.find(path);
+    if (it != materialized.end()) return it->second;
+    Traces t = std::make_shared<const std::vector<TCPTrace>>(viewsLocked(path)->materialize());
+    materialized.emplace(path, t);
+    return t;
+}
+
+DatasetStore::Handles DatasetStore::handles(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m);
+    auto it = interned.find(path);
+    if (it != interned.end()) return it->second;
+    Views v = viewsLocked(path);
+    auto h = std::make_shared<std::vector<uint32_t>>();
+    h->reserve(v->size());
+    for (const TraceView& r : v->records()) h->push_back(id_table.intern(r.trace_id));
+    Handles result = h;
+    interned.emplace(path, result);
+    return result;
+}
+
+uint32_t DatasetStore::intern(std::string_view id) {
+    std::lock_guard<std::mutex> lock(m);
+    return id_table.intern(id);
+}
+
+void DatasetStore::setColumnarCache(bool enabled) {
+    std::lock_guard<std::mutex> lock(m);
+    columnar_cache = enabled;
+}
+
+void DatasetStore::setThreads(int n) {
+    std::lock_guard<std::mutex> lock(m);
+    num_threads = n < 1 ? 1 : n;
+    if (pool && pool->size() != (size_t)num_threads) pool.reset();
+}
+
+size_t DatasetStore::parses() const {
+    std::lock_guard<std::mutex> lock(m);
+    return loaded.size();
+}
+
+size_t DatasetStore::requests() const {
+    std::lock_guard<std::mutex> lock(m);
+    return request_count;
+}
+
+} // namespace CS311
@@ -0,0 +1,80 @@
+/**
+ * DatasetStore.h
+ * Parse-once cache of trace datasets shared by the DFA, content and PDA stages
+ */
+
+#ifndef DATASETSTORE_H
+#define DATASETSTORE_H
+
+#include "Utils.h"
+#include "TraceViewSet.h"
+#include "TraceIdTable.h"
+#include "ThreadPool.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * Each source file (JSONL, or CSV by extension) is mapped and parsed by JSONParser the first
+ * time it is requested; every later request for the same path returns the same immutable
+ * result. views() exposes the records as string views into the mapping; traces() returns
+ * owning TCPTrace copies, built from those views once per path for the stages that keep
+ * their own records. Stages hold the shared_ptr for as long as they use either, so the data
+ * stays valid even if the store itself goes away. Safe to call from several threads.
+ *
+ * With setThreads(n > 1), large files are parsed chunk-parallel on a pool owned by the store.
+ * Paths ending in ".tcol" are read as ColumnarDataset files. With setColumnarCache(true), a
+ * parsed source also gets a "<path>.tcol" sidecar, which later runs map instead of parsing as
+ * long as the source's size and modification time still match.
+ *
+ * Trace ids of every dataset are interned into one TraceIdTable: handles() gives the handle of
+ * each record of a path (computed once per path), so stages can exchange verdicts as Bitmaps
+ * indexed by handle instead of comparing id strings.
+ */
+class DatasetStore {
+public:
+    using Traces = std::shared_ptr<const std::vector<TCPTrace>>;
+    using Views = std::shared_ptr<const TraceViewSet>;
+
+    // Records of a JSONL or CSV trace file (parsed on first request; empty if unreadable)
+    Views views(const std::string& path);
+    Traces traces(const std::string& path);
+
+    using Handles = std::shared_ptr<const std::vector<uint32_t>>;
+    // Interned id of each record of views(path), in record order
+    Handles handles(const std::string& path);
+    // Intern an id that did not come from a loaded dataset (e.g. a synthesized trace)
+    uint32_t intern(std::string_view id);
+    // The shared table; only read it once the stages have finished loading
+    const TraceIdTable& ids() const { return id_table; }
+
+    // Parser threads for large files (1 = sequential); the pool is created on first use
+    void setThreads(int n);
+    // Read/write "<source>.tcol" columnar sidecars instead of re-parsing unchanged sources
+    void setColumnarCache(bool enabled);
+
+    size_t parses() const;    // sources actually read from disk
+    size_t requests() const;  // calls to traces()
+
+private:
+    mutable std::mutex m;
+    std::map<std::string, Views> loaded;
+    std::map<std::string, Traces> materialized;
+    std::map<std::string, Handles> interned;
+    TraceIdTable id_table;
+    size_t request_count = 0;
+    int num_threads = 1;
+    bool columnar_cache = false;
+    std::unique_ptr<ThreadPool> pool;
+
+    Views viewsLocked(const std::string& path);
+    std::shared_ptr<TraceViewSet> parseSource(const std::string& path);
+};
+
+} // namespace CS311
+
+#endif // DATASETSTORE_H
@@ -0,0 +1,319 @@
+/**
+ * JSONLTokenizer.cpp
+ * One-pass tokenizer for single-line JSON records (SIMD structural index + token sweep)
+ */
+
+#include "JSONLTokenizer.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CS311_JSONL_SSE2 1
+#endif
+
+namespace CS311 {
+
+namespace {
+
+struct BlockMasks {
+    uint64_t quote = 0;
+    uint64_t backslash = 0;
+    uint64_t op = 0;     // { } [ ] : ,
+};
+
+#ifdef CS311_JSONL_SSE2
+inline uint64_t mask16(__m128i v, char c) {
+    return (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+}
+
+void classify(const char* block, BlockMasks& m) {
+    for (int k = 0; k < 4; ++k) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * k));
+        int shift = 16 * k;
+        m.quote |= mask16(v, '"') << shift;
+        m.backslash |= mask16(v, '\\') << shift;
+        __m128i ops = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('{')), _mm_cmpeq_epi8(v, _mm_set1_epi8('}'))),
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('[')), _mm_cmpeq_epi8(v, _mm_set1_epi8(']'))),
+                         _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(',')))));
+        m.op |= (uint64_t)(uint32_t)_mm_movemask_epi8(ops) << shift;
+    }
+}
+#else
+void classify(const char* block, BlockMasks& m) {
+    for (int i = 0; i < 64; ++i) {
+        uint64_t bit = 1ULL << i;
+        switch (block[i]) {
+        case '"': m.quote |= bit; break;
+        case '\\': m.backslash |= bit; break;
+        case '{': case '}': case '[': case ']': case ':': case ',': m.op |= bit; break;
+        default: break;
+        }
+    }
+}
+#endif
+
+// Characters preceded by an odd-length backslash run (the escaped ones). `carry` is 1 when the
+// previous block ended with a pending escape, i.e. its first character is escaped.
+inline uint64_t escapedChars(uint64_t backslash, uint64_t& carry) {
+    const uint64_t ODD_BITS = 0xAAAAAAAAAAAAAAAAULL;
+    if (!backslash) {
+        uint64_t escaped = carry;
+        carry = 0;
+        return escaped;
+    }
+    // A backslash that is itself escaped cannot start an escape
+    uint64_t potential = backslash & ~carry;
+    // Subtracting each run from its shifted copy (odd positions preset) flips exactly the bits
+    // that are escape characters and the character right after an odd-length run
+    uint64_t codes = ((potential << 1) | ODD_BITS) - potential;
+    codes ^= ODD_BITS;
+    uint64_t escaped = codes ^ (backslash | carry);
+    carry = (codes & backslash) >> 63;
+    return escaped;
+}
+
+inline uint64_t prefixXor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+inline int lowestBit(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int i = 0;
+    while (!(x & 1)) { x >>= 1; ++i; }
+    return i;
+#endif
+}
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool readHex4(const char* p, const char* end, uint32_t& v) {
+    if (end - p < 4) return false;
+    v = 0;
+    for (int i = 0; i < 4; ++i) {
+        int h = hexValue(p[i]);
+        if (h < 0) return false;
+        v = (v << 4) | (uint32_t)h;
+    }
+    return true;
+}
+
+// Encoded length never exceeds the escape it came from (\uXXXX: 6 bytes, pairs: 12)
+char* appendUtf8(char* o, uint32_t cp) {
+    if (cp < 0x80) {
+        *o++ = (char)cp;
+    } else if (cp < 0x800) {
+        *o++ = (char)(0xC0 | (cp >> 6));
+        *o++ = (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        *o++ = (char)(0xE0 | (cp >> 12));
+        *o++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *o++ = (char)(0x80 | (cp & 0x3F));
+    } else {
+        *o++ = (char)(0xF0 | (cp >> 18));
+        *o++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+        *o++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *o++ = (char)(0x80 | (cp & 0x3F));
+    }
+    return o;
+}
+
+} // namespace
+
+bool JSONLTokenizer::simdEnabled() {
+#ifdef CS311_JSONL_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+void JSONLTokenizer::indexStructurals() {
+    structurals.clear();
+    uint64_t escape_carry = 0;
+    uint64_t in_string = 0;  // all ones when the previous block ended inside a string
+    char tail[64];
+    for (size_t off = 0; off < size; off += 64) {
+        const char* block = base + off;
+        size_t len = size - off;
+        if (len < 64) {
+            std::memset(tail, ' ', sizeof(tail));
+            std::memcpy(tail, block, len);
+            block = tail;
+        }
+        BlockMasks m;
+        classify(block, m);
+        uint64_t escaped = escapedChars(m.backslash, escape_carry);
+        uint64_t quotes = m.quote & ~escaped;
+        uint64_t inside = prefixXor(quotes) ^ in_string;
+        in_string = (uint64_t)((int64_t)inside >> 63);
+        uint64_t bits = (m.op & ~inside) | quotes;
+        while (bits) {
+            structurals.push_back((uint32_t)(off + lowestBit(bits)));
+            bits &= bits - 1;
+        }
+    }
+    if (in_string) err = "unterminated string";
+}
+
+bool JSONLTokenizer::tokenize(const char* data, size_t n) {
+    base = data;
+    size = n;
+    toks.clear();
+    err.clear();
+    indexStructurals();
+    if (!err.empty()) return false;
+
+    std::vector<uint32_t>& open = open_containers;
+    open.clear();
+    char prev = 0;               // previous structural character
+    size_t prev_pos = 0;
+    auto scalarBefore = [&](size_t pos) {
+        if (prev != ':' && prev != ',' && prev != '[') return;
+        size_t b = prev_pos + 1, e = pos;
+        while (b < e && isSpace(base[b])) ++b;
+        while (e > b && isSpace(base[e - 1])) --e;
+        if (b < e) toks.push_back(Token{ Type::Scalar, false, (uint32_t)b, (uint32_t)(e - b), 0 });
+    };
+
+    for (size_t s = 0; s < structurals.size(); ++s) {
+        size_t pos = structurals[s];
+        char c = base[pos];
+        switch (c) {
+        case '{':
+        case '[':
+            open.push_back((uint32_t)toks.size());
+            toks.push_back(Token{ c == '{' ? Type::ObjectBegin : Type::ArrayBegin, false, (uint32_t)pos, 0, 0 });
+            break;
+        case '}':
+        case ']': {
+            scalarBefore(pos);
+            Type want = c == '}' ? Type::ObjectBegin : Type::ArrayBegin;
+            if (open.empty() || toks[open.back()].type != want) {
+                err = std::string("unbalanced '") + c + "'";
+                return false;
+            }
+            toks[open.back()].end = (uint32_t)toks.size();
+            open.pop_back();
+            toks.push_back(Token{ c == '}' ? Type::ObjectEnd : Type::ArrayEnd, false, (uint32_t)pos, 0, 0 });
+            break;
+        }
+        case ',':
+            scalarBefore(pos);
+            break;
+        case '"': {
+            // Stage 1 masks everything inside strings, so the next structural closes this one
+            size_t close = structurals[++s];
+            size_t b = pos + 1;
+            bool esc = std::memchr(base + b, '\\', close - b) != nullptr;
+            toks.push_back(Token{ Type::String, esc, (uint32_t)b, (uint32_t)(close - b), 0 });
+            pos = close;
+            break;
+        }
+        default: // ':'
+            break;
+        }
+        prev = c;
+        prev_pos = pos;
+    }
+    if (!open.empty()) {
+        err = "unclosed container";
+        return false;
+    }
+    return true;
+}
+
+size_t JSONLTokenizer::decode(const Token& t, char* out) const {
+    const char* p = base + t.begin;
+    const char* end = p + t.length;
+    char* o = out;
+    if (!t.escaped) {
+        std::memcpy(o, p, t.length);
+        return t.length;
+    }
+    while (p < end) {
+        const char* bs = static_cast<const char*>(std::memchr(p, '\\', (size_t)(end - p)));
+        if (!bs) {
+            std::memcpy(o, p, (size_t)(end - p));
+            o += end - p;
+            break;
+        }
+        std::memcpy(o, p, (size_t)(bs - p));
+        o += bs - p;
+        p = bs + 1;
+        if (p == end) { *o++ = '\\'; break; }
+        char e = *p++;
+        switch (e) {
+        case '"': *o++ = '"'; break;
+        case '\\': *o++ = '\\'; break;
+        case '/': *o++ = '/'; break;
+        case 'b': *o++ = '\b'; break;
+        case 'f': *o++ = '\f'; break;
+        case 'n': *o++ = '\n'; break;
+        case 'r': *o++ = '\r'; break;
+        case 't': *o++ = '\t'; break;
+        case 'u': {
+            uint32_t cp;
+            if (!readHex4(p, end, cp)) { *o++ = '\\'; *o++ = 'u'; break; }
+            p += 4;
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                uint32_t lo;
+                if (end - p >= 6 && p[0] == '\\' && p[1] == 'u' && readHex4(p + 2, end, lo) && lo >= 0xDC00 && lo <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    p += 6;
+                } else {
+                    cp = 0xFFFD; // lone high surrogate
+                }
+            } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                cp = 0xFFFD;     // lone low surrogate
+            }
+            o = appendUtf8(o, cp);
+            break;
+        }
+        default: // not a JSON escape: keep it as written
+            *o++ = '\\';
+            *o++ = e;
+            break;
+        }
+    }
+    return (size_t)(o - out);
+}
+
+void JSONLTokenizer::text(const Token& t, std::string& out) const {
+    out.resize(t.length);
+    out.resize(decode(t, &out[0]));
+}
+
+std::string JSONLTokenizer::text(const Token& t) const {
+    std::string out;
+    text(t, out);
+    return out;
+}
+
+bool JSONLTokenizer::equals(const Token& t, const char* literal) const {
+    size_t n = std::strlen(literal);
+    return t.length == n && std::memcmp(base + t.begin, literal, n) == 0;
+}
+
+size_t JSONLTokenizer::skip(size_t i) const {
+    const Token& t = toks[i];
+    if (t.type == Type::ObjectBegin || t.type == Type::ArrayBegin) return t.end + 1;
+    return i + 1;
+}
+
+} // namespace CS311
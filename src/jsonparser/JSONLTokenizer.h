@@ -0,0 +1,76 @@
+/**
+ * JSONLTokenizer.h
+ * One-pass tokenizer for single-line JSON records (SIMD structural index + token sweep)
+ */
+
+#ifndef JSONLTOKENIZER_H
+#define JSONLTOKENIZER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * Two stages, after simdjson:
+ *   1. Structural index. The line is classified 64 bytes at a time (SSE2 compares + movemask
+ *      where available, a byte loop otherwise) into quote, backslash and operator bitmasks.
+ *      Escaped quotes are removed with carry-propagating bit arithmetic, the in-string mask is
+ *      the prefix XOR of the remaining quotes, and the structural characters are the operators
+ *      { } [ ] : , outside strings plus the string delimiters themselves.
+ *   2. Token sweep. The structural positions are walked once to produce a flat token list:
+ *      containers (with the index of their closing token, so values can be skipped in O(1)),
+ *      strings (raw span, escape flag) and bare scalars (true/false/null/numbers, trimmed).
+ *
+ * Strings are decoded on demand by text(): \" \\ \/ \b \f \n \r \t and \uXXXX (including
+ * surrogate pairs, emitted as UTF-8). Unknown escapes are kept verbatim. The tokenizer owns
+ * its buffers and reuses them across lines; one instance per thread.
+ */
+class JSONLTokenizer {
+public:
+    enum class Type : uint8_t { ObjectBegin, ObjectEnd, ArrayBegin, ArrayEnd, String, Scalar };
+    struct Token {
+        Type type;
+        bool escaped;     // String: contains at least one backslash
+        uint32_t begin;   // byte offset of the content (strings: after the opening quote)
+        uint32_t length;  // content length (strings: without quotes)
+        uint32_t end;     // containers: index of the matching closing token
+    };
+
+    // Tokenize one JSON text; returns false (with error()) if quotes or brackets do not balance
+    bool tokenize(const char* data, size_t n);
+    const std::vector<Token>& tokens() const { return toks; }
+    const std::string& error() const { return err; }
+
+    // Decoded string / raw scalar text of a token
+    std::string text(const Token& t) const;
+    void text(const Token& t, std::string& out) const;
+    // Decode into `out` (needs t.length bytes; decoding never grows) and return the length used
+    size_t decode(const Token& t, char* out) const;
+    // Undecoded bytes of a token, pointing into the tokenized input
+    std::string_view raw(const Token& t) const { return std::string_view(base + t.begin, t.length); }
+    // Raw (undecoded) comparison, for keys
+    bool equals(const Token& t, const char* literal) const;
+    // Index of the token after the value starting at token i
+    size_t skip(size_t i) const;
+
+    // True when the SIMD classifier is compiled in (false: portable byte loop)
+    static bool simdEnabled();
+
+private:
+    const char* base = nullptr;
+    size_t size = 0;
+    std::vector<uint32_t> structurals;
+    std::vector<Token> toks;
+    std::vector<uint32_t> open_containers; // token indices of unclosed containers
+    std::string err;
+
+    void indexStructurals();
+};
+
+} // namespace CS311
+
+#endif // JSONLTOKENIZER_H
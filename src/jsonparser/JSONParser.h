@@ -7,27 +7,57 @@
 #define JSONPARSER_H
 
 #include "Utils.h"
+#include "JSONLTokenizer.h"
+#include "TraceViewSet.h"
+#include "CSVReader.h"
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 
 namespace CS311 {
 
+class ThreadPool;
+
 class JSONParser {
 private:
-    // Helper to extract string value from JSON
-    static std::string extractString(const std::string& src, const std::string& key);
-    
-    // Parse individual entries
-    static FilenameEntry parseFilenameEntrySimple(const std::string& line);
-    static TCPTrace parseTCPTraceSimple(const std::string& line);
+    friend class TraceStream;
+    // Parse individual entries (one tokenizer sweep per line; throws on malformed JSON)
+    static FilenameEntry parseFilenameEntry(JSONLTokenizer& tok, const std::string& line);
+    // Appends the trace on `line` to `set` (false: nothing added). Malformed lines throw.
+    using LineParser = bool (*)(JSONLTokenizer& tok, std::string_view line, TraceViewSet& set);
+    static bool parseTCPTraceView(JSONLTokenizer& tok, std::string_view line, TraceViewSet& set);
+    // Column of each trace field in a CSV dataset; -1 = absent
+    struct TraceColumns {
+        int trace_id = 0, sequence = 1, valid = 2, description = 3, category = 4, content = 5;
+    };
+    // Columns named in the header record; names it lacks keep their positional default
+    static TraceColumns traceColumns(const CSVReader& header);
+    static bool parseTCPTraceCSVRecord(const CSVReader& record, const TraceColumns& cols, TraceViewSet& set);
+    // Parse every record of `text` (line numbers start at `firstLine`) into `set`: JSONL lines
+    // with `parse`, or CSV records when `csv` is given. With a pool of more than one thread,
+    // large inputs are split at record boundaries and parsed chunk-parallel; the records and
+    // per-line warnings still come out in file order. With `partialTail`, a last record that
+    // is not ended by a line break is left unparsed. Returns the number of bytes consumed.
+    static size_t parseRecords(std::string_view text, size_t firstLine, TraceViewSet& set,
+                               ThreadPool* pool, LineParser parse, const TraceColumns* csv = nullptr,
+                               bool partialTail = false);
+    // String token as a view: into the mapping when verbatim, else decoded into the set's arena
+    static std::string_view fieldView(const JSONLTokenizer& tok, const JSONLTokenizer::Token& t, TraceViewSet& set);
 
 public:
     // Load datasets from JSONL files
     static std::vector<FilenameEntry> loadFilenameDataset(const std::string& filepath);
-    static std::vector<TCPTrace> loadTCPDataset(const std::string& filepath);
+    static std::vector<TCPTrace> loadTCPDataset(const std::string& filepath, ThreadPool* pool = nullptr);
     // Load TCP traces from CSV (trace_id,sequence,valid,description,category[,content])
-    static std::vector<TCPTrace> loadTCPDatasetCSV(const std::string& filepath);
+    static std::vector<TCPTrace> loadTCPDatasetCSV(const std::string& filepath, ThreadPool* pool = nullptr);
+    // Same datasets as views into the mapped file (no per-field allocations); a pool enables
+    // chunk-parallel parsing of large files
+    static std::shared_ptr<TraceViewSet> mapTCPDataset(const std::string& filepath, ThreadPool* pool = nullptr);
+    static std::shared_ptr<TraceViewSet> mapTCPDatasetCSV(const std::string& filepath, ThreadPool* pool = nullptr);
+    // "[SUCCESS] Loaded N TCP traces<suffix>" plus valid/invalid counts
+    static void printTraceSummary(const TraceViewSet& set, const char* suffix);
 };
 
 } // namespace CS311
@@ -0,0 +1,91 @@
+/**
+ * TraceIdTable.cpp
+ * Interning of trace ids into dense integer handles shared by all datasets of a run
+ */
+
+#include "TraceIdTable.h"
+#include "Utils.h"
+#include <cctype>
+#include <cstring>
+
+namespace CS311 {
+
+namespace {
+// ASCII lowercase of 8 bytes at once: 0x20 is added to every byte in 'A'..'Z'
+inline uint64_t lower8(uint64_t w) {
+    const uint64_t ones = 0x0101010101010101ULL;
+    uint64_t low7 = w & (0x7F * ones);
+    uint64_t atLeastA = low7 + (0x80 - 'A') * ones;
+    uint64_t aboveZ = low7 + (0x80 - 'Z' - 1) * ones;
+    uint64_t upper = (atLeastA ^ aboveZ) & ~w & (0x80 * ones);
+    return w | (upper >> 2);
+}
+
+inline char lower1(char c) { return (char)std::tolower((unsigned char)c); }
+} // namespace
+
+// Same mixing as hashBytes64, over the lowercased bytes
+uint64_t TraceIdTable::foldedHash(std::string_view id) {
+    const char* p = id.data();
+    size_t len = id.size();
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ (uint64_t)len;
+    while (len >= 8) {
+        uint64_t k;
+        std::memcpy(&k, p, 8);
+        h ^= mix64(lower8(k));
+        h = ((h << 27) | (h >> 37)) * 0x9e3779b97f4a7c15ULL + 0x52dce729ULL;
+        p += 8; len -= 8;
+    }
+    uint64_t tail = 0;
+    if (len) std::memcpy(&tail, p, len);
+    h ^= mix64(lower8(tail) ^ 0x2545f4914f6cdd1dULL);
+    return mix64(h);
+}
+
+bool TraceIdTable::matches(uint32_t handle, std::string_view id) const {
+    std::string_view stored = name(handle);
+    if (stored.size() != id.size()) return false;
+    for (size_t i = 0; i < id.size(); ++i) {
+        if (stored[i] != lower1(id[i])) return false;
+    }
+    return true;
+}
+
+void TraceIdTable::rebuild(size_t slotCount) {
+    slots.assign(slotCount, NONE);
+    slot_mask = slotCount - 1;
+    for (uint32_t h = 0; h < (uint32_t)hashes.size(); ++h) {
+        size_t i = (size_t)hashes[h] & slot_mask;
+        while (slots[i] != NONE) i = (i + 1) & slot_mask;
+        slots[i] = h;
+    }
+}
+
+uint32_t TraceIdTable::find(std::string_view id) const {
+    if (slots.empty()) return NONE;
+    uint64_t hash = foldedHash(id);
+    for (size_t i = (size_t)hash & slot_mask; slots[i] != NONE; i = (i + 1) & slot_mask) {
+        uint32_t h = slots[i];
+        if (hashes[h] == hash && matches(h, id)) return h;
+    }
+    return NONE;
+}
+
+uint32_t TraceIdTable::intern(std::string_view id) {
+    // Keep the load factor at or below 1/2
+    if ((size() + 1) * 2 > slots.size()) rebuild(slots.empty() ? 1024 : slots.size() * 2);
+    uint64_t hash = foldedHash(id);
+    size_t i = (size_t)hash & slot_mask;
+    for (; slots[i] != NONE; i = (i + 1) & slot_mask) {
+        uint32_t h = slots[i];
+        if (hashes[h] == hash && matches(h, id)) return h;
+    }
+    uint32_t handle = (uint32_t)size();
+    slots[i] = handle;
+    hashes.push_back(hash);
+    for (char c : id) pool.push_back(lower1(c));
+    offsets.push_back(pool.size());
+    return handle;
+}
+
+} // namespace CS311
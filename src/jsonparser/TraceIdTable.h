@@ -0,0 +1,55 @@
+/**
+ * TraceIdTable.h
+ * Interning of trace ids into dense integer handles shared by all datasets of a run
+ */
+
+#ifndef TRACEIDTABLE_H
+#define TRACEIDTABLE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * Maps each distinct trace id, compared ASCII case-insensitively (the pipeline's identifier
+ * normalization), to a handle 0..size()-1 in order of first appearance. Stages then carry
+ * per-id verdicts as Bitmaps indexed by handle, so joining stages and datasets is bitwise
+ * work instead of lowercased string copies and tree lookups.
+ *
+ * Lowercased ids are stored back to back in one pool; the index is an open-addressing table
+ * of handles with linear probing, keyed by a case-folding hash computed 8 bytes at a time.
+ * intern() and find() do not allocate except when the pool or index grows. Not thread-safe:
+ * DatasetStore serializes intern() calls.
+ */
+class TraceIdTable {
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    // Handle of `id`, assigning the next one on first sight
+    uint32_t intern(std::string_view id);
+    // Handle of `id`, or NONE if it was never interned
+    uint32_t find(std::string_view id) const;
+    // Lowercased id behind a handle
+    std::string_view name(uint32_t handle) const {
+        return std::string_view(pool.data() + offsets[handle], offsets[handle + 1] - offsets[handle]);
+    }
+    size_t size() const { return offsets.size() - 1; }
+
+private:
+    std::string pool;
+    std::vector<size_t> offsets{0};
+    std::vector<uint64_t> hashes;     // per handle, for rebuilding the index
+    std::vector<uint32_t> slots;      // handle or NONE; size is a power of two
+    size_t slot_mask = 0;
+
+    static uint64_t foldedHash(std::string_view id);
+    bool matches(uint32_t handle, std::string_view id) const;
+    void rebuild(size_t slotCount);
+};
+
+} // namespace CS311
+
+#endif // TRACEIDTABLE_H
@@ -0,0 +1,80 @@
+/**
+ * TraceStream.cpp
+ * Batch-at-a-time reader for trace datasets of any size (files or standard input)
+ */
+
+#include "TraceStream.h"
+#include "JSONParser.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace CS311 {
+
+TraceStream::TraceStream(size_t bufferBytes) : buffer(std::max<size_t>(bufferBytes, 4096)) {}
+
+bool TraceStream::open(const std::string& path) {
+    if (path == "-") {
+        in = &std::cin;
+    } else {
+        file.open(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        in = &file;
+    }
+    filled = consumed = 0;
+    at_eof = sniffed = csv = false;
+    next_line = 1;
+    records_read = bytes_read = 0;
+    current.clear();
+    return true;
+}
+
+bool TraceStream::next() {
+    current.clear();
+    while (in) {
+        // Drop the records of the previous batch; the partial record after them moves to the front
+        if (consumed > 0) {
+            std::memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+            filled -= consumed;
+            consumed = 0;
+        }
+        if (!at_eof) {
+            // A record longer than the whole buffer: grow to fit it
+            if (filled == buffer.size()) buffer.resize(buffer.size() * 2);
+            in->read(buffer.data() + filled, (std::streamsize)(buffer.size() - filled));
+            size_t got = (size_t)in->gcount();
+            filled += got;
+            bytes_read += got;
+            if (!*in) at_eof = true;
+        }
+        std::string_view text(buffer.data(), filled);
+        size_t offset = 0;
+        if (!sniffed) {
+            size_t first = text.find_first_not_of(" \t\r\n");
+            if (first == std::string_view::npos) {
+                if (at_eof) break;
+                continue;
+            }
+            csv = text[first] != '{';
+            if (csv) {
+                CSVReader header(text);
+                if (!header.next() || (!header.terminated() && !at_eof)) continue;
+                columns = JSONParser::traceColumns(header);
+                offset = header.position();
+                next_line += header.linesConsumed();
+            }
+            sniffed = true;
+        }
+        size_t used = JSONParser::parseRecords(text.substr(offset), next_line, current, nullptr,
+                                               &JSONParser::parseTCPTraceView, csv ? &columns : nullptr, !at_eof);
+        next_line += (size_t)std::count(text.begin() + offset, text.begin() + offset + used, '\n');
+        consumed = offset + used;
+        records_read += current.size();
+        if (current.size() > 0) return true;
+        if (at_eof && consumed == filled) break;
+    }
+    in = nullptr;
+    return false;
+}
+
+} // namespace CS311
@@ -0,0 +1,67 @@
+/**
+ * TraceStream.h
+ * Batch-at-a-time reader for trace datasets of any size (files or standard input)
+ */
+
+#ifndef TRACESTREAM_H
+#define TRACESTREAM_H
+
+#include "TraceViewSet.h"
+#include "JSONParser.h"
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * Reads a JSONL or CSV trace source through one fixed buffer and hands it out as batches of
+ * whole records. Each batch is parsed with the same line parsers as JSONParser::mapTCPDataset
+ * and its views point into the buffer, so they stay valid only until the next call to next().
+ * Memory is bounded by the buffer size (which only grows to fit a single longer line) no
+ * matter how long the input is.
+ *
+ * The format is told from the first byte: '{' starts a JSONL stream, anything else is taken
+ * as a CSV header record naming the columns (trace_id,sequence,valid,description,category
+ * [,content] by default). CSV batches end at record boundaries, so quoted fields may span
+ * lines.
+ */
+class TraceStream {
+public:
+    static constexpr size_t DEFAULT_BUFFER_BYTES = 1 << 20;
+
+    explicit TraceStream(size_t bufferBytes = DEFAULT_BUFFER_BYTES);
+    TraceStream(const TraceStream&) = delete;
+    TraceStream& operator=(const TraceStream&) = delete;
+
+    // "-" reads standard input; false if the file cannot be opened
+    bool open(const std::string& path);
+    // Parse the next buffer of complete lines into batch(); false once the input is exhausted
+    bool next();
+    const TraceViewSet& batch() const { return current; }
+
+    bool isCSV() const { return csv; }
+    size_t recordsRead() const { return records_read; }
+    size_t bytesRead() const { return bytes_read; }
+    size_t bufferBytes() const { return buffer.size(); }
+
+private:
+    std::ifstream file;
+    std::istream* in = nullptr;
+    std::vector<char> buffer;
+    size_t filled = 0;     // bytes in the buffer
+    size_t consumed = 0;   // prefix handed out by the last batch, dropped on the next call
+    bool at_eof = false;
+    bool sniffed = false;
+    bool csv = false;
+    JSONParser::TraceColumns columns;
+    size_t next_line = 1;
+    size_t records_read = 0;
+    size_t bytes_read = 0;
+    TraceViewSet current;
+};
+
+} // namespace CS311
+
+#endif // TRACESTREAM_H
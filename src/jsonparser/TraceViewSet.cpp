@@ -0,0 +1,99 @@
+/**
+ * TraceViewSet.cpp
+ * Trace dataset held as string views into the memory-mapped source file
+ */
+
+#include "TraceViewSet.h"
+
+namespace CS311 {
+
+char* TraceViewSet::allocate(size_t n) {
+    if (n > arena_left) {
+        // Oversized values get a block of their own; the rest share 64 KiB blocks
+        size_t block = n > ARENA_BLOCK_BYTES ? n : ARENA_BLOCK_BYTES;
+        arena.emplace_back(new char[block]);
+        arena_cursor = arena.back().get();
+        arena_left = block;
+    }
+    char* p = arena_cursor;
+    arena_cursor += n;
+    arena_left -= n;
+    arena_used += n;
+    return p;
+}
+
+void TraceViewSet::addRecord(const TraceView& v, size_t firstPacket) {
+    views.push_back(v);
+    packet_spans.emplace_back(firstPacket, packets.size());
+}
+
+void TraceViewSet::adopt(TraceViewSet&& part) {
+    views.swap(part.views);
+    packets.swap(part.packets);
+    tokens.swap(part.tokens);
+    packet_spans.swap(part.packet_spans);
+    arena.swap(part.arena);
+    arena_cursor = part.arena_cursor;
+    arena_left = part.arena_left;
+    arena_used = part.arena_used;
+}
+
+void TraceViewSet::append(TraceViewSet&& part) {
+    if (views.empty() && packets.empty() && arena.empty()) {
+        adopt(std::move(part));
+        return;
+    }
+    size_t base = packets.size();
+    views.insert(views.end(), part.views.begin(), part.views.end());
+    packets.insert(packets.end(), part.packets.begin(), part.packets.end());
+    tokens.insert(tokens.end(), part.tokens.begin(), part.tokens.end());
+    packet_spans.reserve(packet_spans.size() + part.packet_spans.size());
+    for (const auto& span : part.packet_spans) packet_spans.emplace_back(base + span.first, base + span.second);
+    // Arena blocks change owner but not address, so decoded views stay valid; the current
+    // block's tail is not reused after a merge
+    for (auto& block : part.arena) arena.push_back(std::move(block));
+    arena_cursor = nullptr;
+    arena_left = 0;
+    arena_used += part.arena_used;
+}
+
+void TraceViewSet::finish() {
+    for (size_t i = 0; i < views.size(); ++i) {
+        views[i].sequence = PacketRange(packets.data() + packet_spans[i].first, packets.data() + packet_spans[i].second,
+                                        tokens.data() + packet_spans[i].first);
+    }
+    packet_spans.clear();
+    packet_spans.shrink_to_fit();
+}
+
+void TraceViewSet::clear() {
+    views.clear();
+    packets.clear();
+    tokens.clear();
+    packet_spans.clear();
+    arena.clear();
+    arena_cursor = nullptr;
+    arena_left = 0;
+    arena_used = 0;
+}
+
+TCPTrace TraceViewSet::materialize(const TraceView& v) const {
+    TCPTrace t;
+    t.trace_id.assign(v.trace_id);
+    t.sequence.reserve(v.sequence.size());
+    for (const auto& packet : v.sequence) t.sequence.emplace_back(packet);
+    t.valid = v.valid;
+    t.description.assign(v.description);
+    t.category.assign(v.category);
+    t.content.assign(v.content);
+    return t;
+}
+
+std::vector<TCPTrace> TraceViewSet::materialize() const {
+    std::vector<TCPTrace> out;
+    out.reserve(views.size());
+    for (const auto& v : views) out.push_back(materialize(v));
+    return out;
+}
+
+} // namespace CS311
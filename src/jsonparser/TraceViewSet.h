@@ -0,0 +1,85 @@
+/**
+ * TraceViewSet.h
+ * Trace dataset held as string views into the memory-mapped source file
+ */
+
+#ifndef TRACEVIEWSET_H
+#define TRACEVIEWSET_H
+
+#include "Utils.h"
+#include "MappedFile.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * Owns the mapping of one trace file and the TraceView records parsed from it. Field values
+ * that appear verbatim in the file (nearly all of them) point straight into the mapping; values
+ * that needed unescaping are decoded once into an arena of fixed-size blocks, so a load costs
+ * the mapping, the record and packet arrays and a few arena blocks instead of one heap string
+ * per field and per packet. Views stay valid for the lifetime of the set, which is why it is
+ * neither copyable nor movable and is handed around as a shared_ptr.
+ *
+ * Packets of all records are stored once, in CSR form: one array of packet views and a
+ * parallel array of one-byte PacketTokens, interned as each packet is parsed, with every
+ * record's PacketRange marking its [begin, end) slice. Validating a dataset in record order
+ * is therefore a linear walk over contiguous token bytes.
+ *
+ * Filled by JSONParser::mapTCPDataset / mapTCPDatasetCSV, mapped from a columnar file by
+ * ColumnarDataset::read, or refilled batch by batch by TraceStream.
+ */
+class TraceViewSet {
+public:
+    TraceViewSet() = default;
+    TraceViewSet(const TraceViewSet&) = delete;
+    TraceViewSet& operator=(const TraceViewSet&) = delete;
+
+    const std::vector<TraceView>& records() const { return views; }
+    size_t size() const { return views.size(); }
+    bool isMapped() const { return file.isMapped(); }
+    size_t arenaBytes() const { return arena_used; }
+    // Token array shared by all records (see PacketRange::tokens())
+    const std::vector<PacketToken>& packetTokens() const { return tokens; }
+
+    // Owning copies, for stages that keep their own TCPTrace records
+    TCPTrace materialize(const TraceView& v) const;
+    std::vector<TCPTrace> materialize() const;
+
+private:
+    friend class JSONParser;
+    friend class ColumnarDataset;
+    friend class TraceStream;
+    static constexpr size_t ARENA_BLOCK_BYTES = 64 * 1024;
+
+    MappedFile file;
+    std::vector<TraceView> views;
+    std::vector<std::string_view> packets;
+    std::vector<PacketToken> tokens;     // packetToken() of each entry of `packets`
+    std::vector<std::unique_ptr<char[]>> arena;
+    char* arena_cursor = nullptr;
+    size_t arena_left = 0;
+    size_t arena_used = 0;
+
+    // Packet ranges are kept as offsets while `packets` may still reallocate
+    std::vector<std::pair<size_t, size_t>> packet_spans;
+
+    char* allocate(size_t n);
+    void addPacket(std::string_view packet) {
+        packets.push_back(packet);
+        tokens.push_back(packetToken(packet));
+    }
+    void addRecord(const TraceView& v, size_t firstPacket);
+    // Take over the records of a set parsed from a chunk of this set's file (not finished yet)
+    void adopt(TraceViewSet&& part);
+    void append(TraceViewSet&& part);
+    void finish();
+    // Drop every record and arena block (the mapping, if any, is kept)
+    void clear();
+};
+
+} // namespace CS311
+
+#endif // TRACEVIEWSET_H
@@ -12,11 +12,17 @@
 #include "DFAModule.h"
 #include "PDAModule.h"
 #include "AutomataJSON.h"
+#include "VerdictStore.h"
+#include "DatasetStore.h"
+#include "ColumnarDataset.h"
+#include "StreamPipeline.h"
 
 #include <string>
 #include <sstream>
 #include <fstream>
 #include <algorithm>
+#include <cstdlib>
+#include <thread>
 
 using namespace CS311;
 
@@ -42,6 +48,29 @@ int main(int argc, char* argv[]) {
     bool dfaVerbose = false;
     bool strictHandshake = false;
     std::vector<std::string> filePaths;
+    // Benign allowlist patterns compiled out of the filename DFAs (pattern \ allowlist)
+    std::vector<std::string> allowPatterns;
+    // Exact-name / suffix blocklist compiled into minimal acyclic DFAs
+    std::string blocklistPath;
+    // Known-IOC prefilter: malware.csv-style source or serialized filter
+    std::string iocFilterPath;
+    // Worker threads for dataset classification (1 = sequential)
+    int numThreads = 1;
+    bool threadsGiven = false;
+    // Parallel recursive directory sweep (--scan-dir <root>)
+    std::string scanDirRoot;
+    // Verdict memo entries per cache (--cache-size 0 disables)
+    long cacheSize = -1;
+    // Persistent per-record verdicts reused by later runs (--verdict-store <file>)
+    std::string verdictStorePath;
+    // Columnar .tcol sidecars next to trace sources (--columnar-cache) and one-shot conversion
+    bool columnarCache = false;
+    std::string convertIn, convertOut;
+    // Constant-memory pipeline over trace sources (--stream <file|->, repeatable)
+    std::vector<std::string> streamPaths;
+    // Incremental per-connection PDA over interleaved trace packets (--flow-replay <file>)
+    std::string flowReplayPath;
+    long flowConcurrency = 4096;
     // Carry DFA-suspicious filenames across to PDA
     std::vector<std::string> suspiciousGlobal;
     // Parse arguments: files imply scanMode; flag --dfa-verbose enables verbose DFA
@@ -51,6 +80,34 @@ int main(int argc, char* argv[]) {
             dfaVerbose = true;
         } else if (arg == "--strict-handshake") {
             strictHandshake = true;
+        } else if (arg == "--allow" && i + 1 < argc) {
+            allowPatterns.push_back(argv[++i]);
+        } else if (arg == "--blocklist" && i + 1 < argc) {
+            blocklistPath = argv[++i];
+        } else if (arg == "--ioc-filter" && i + 1 < argc) {
+            iocFilterPath = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            numThreads = std::atoi(argv[++i]);
+            if (numThreads <= 0) numThreads = (int)std::thread::hardware_concurrency();
+            threadsGiven = true;
+        } else if (arg == "--cache-size" && i + 1 < argc) {
+            cacheSize = std::atol(argv[++i]);
+        } else if (arg == "--verdict-store" && i + 1 < argc) {
+            verdictStorePath = argv[++i];
+        } else if (arg == "--columnar-cache") {
+            columnarCache = true;
+        } else if (arg == "--convert-columnar" && i + 2 < argc) {
+            convertIn = argv[++i];
+            convertOut = argv[++i];
+        } else if (arg == "--stream" && i + 1 < argc) {
+            streamPaths.push_back(argv[++i]);
+        } else if (arg == "--flow-replay" && i + 1 < argc) {
+            flowReplayPath = argv[++i];
+        } else if (arg == "--flow-concurrency" && i + 1 < argc) {
+            flowConcurrency = std::atol(argv[++i]);
+        } else if (arg == "--scan-dir" && i + 1 < argc) {
+            scanDirRoot = argv[++i];
+            scanMode = true;
         } else {
             scanMode = true;
             filePaths.push_back(arg);
@@ -80,20 +137,96 @@ int main(int argc, char* argv[]) {
     std::cout << "• Function: pattern matching" << std::endl;
     std::cout << std::endl;
     
+    // Every trace file is parsed once and shared read-only by the DFA, content and PDA stages
+    auto datasets = std::make_shared<DatasetStore>();
     DFAModule dfaModule;
+    dfaModule.setDatasetStore(datasets);
     // Use multiple DFAs (one per pattern) for true substring matching
     dfaModule.setCombineAllPatterns(false);
+    dfaModule.setAllowlistPatterns(allowPatterns);
+    // Directory sweeps default to all cores; dataset classification defaults to one thread
+    if (!scanDirRoot.empty() && !threadsGiven) numThreads = (int)std::thread::hardware_concurrency();
+    dfaModule.setThreads(numThreads);
+    datasets->setThreads(numThreads);
+    datasets->setColumnarCache(columnarCache);
+    // Before any mode branch: streaming classifies through the same verdict caches, blocklists
+    // and IOC filter as the batch pipeline
+    if (cacheSize >= 0) dfaModule.setVerdictCacheCapacity((size_t)cacheSize);
+    std::filesystem::create_directories("output");
+    if (!blocklistPath.empty()) dfaModule.loadBlocklist(blocklistPath);
+    if (!iocFilterPath.empty()) dfaModule.loadIOCFilter(iocFilterPath);
+    if (!convertIn.empty()) {
+        ColumnarDataset::SourceStamp stamp;
+        ColumnarDataset::stampOf(convertIn, stamp);
+        DatasetStore::Views source = datasets->views(convertIn);
+        std::string error;
+        if (source->size() == 0 || !ColumnarDataset::write(*source, convertOut, stamp, error)) {
+            std::cerr << "[ERROR] Columnar conversion failed: " << (error.empty() ? "no traces in " + convertIn : error) << std::endl;
+            return 1;
+        }
+        std::cout << "[SUCCESS] Wrote columnar dataset: " << convertOut << std::endl;
+        return 0;
+    }
+    if (!streamPaths.empty()) {
+        // STREAMING MODE: records flow through filename DFA → content DFA → PDA one batch at a
+        // time; nothing is staged, so memory does not grow with the input
+        if (!verdictStorePath.empty()) {
+            std::cerr << "[WARN] --verdict-store is not used in streaming mode" << std::endl;
+        }
+        try {
+            dfaModule.definePatterns();
+            dfaModule.buildNFAs();
+            dfaModule.convertToDFAs();
+            dfaModule.minimizeDFAs();
+            dfaModule.eliminateRedundantPatterns();
+            dfaModule.defineContentPatterns();
+            dfaModule.buildContentNFAs();
+            dfaModule.convertContentToDFAs();
+            dfaModule.minimizeContentDFAs();
+            PDAModule pdaModule;
+            if (strictHandshake) pdaModule.setStrictHandshake(true);
+            pdaModule.defineCFG();
+            pdaModule.buildPDA();
+
+            StreamPipeline pipeline(dfaModule, pdaModule);
+            std::ofstream rejected("output/final_malicious_ids.txt");
+            bool ok = true;
+            for (const auto& path : streamPaths) ok = pipeline.run(path, rejected) && ok;
+            rejected.close();
+            pipeline.generateReport();
+            dfaModule.printVerdictCacheStats();
+            return ok ? 0 : 1;
+        } catch (const std::exception& e) {
+            std::cerr << "[ERROR] Streaming pipeline failed: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    if (!flowReplayPath.empty()) {
+        // FLOW MODE: packets of many connections arrive interleaved and are validated one at a
+        // time through the PDA's flow table; verdicts are checked against whole-trace validation
+        PDAModule pdaModule;
+        pdaModule.setDatasetStore(datasets);
+        if (strictHandshake) pdaModule.setStrictHandshake(true);
+        pdaModule.defineCFG();
+        pdaModule.buildPDA();
+        // --threads N: N flow-sharded workers, each with its own flow table
+        size_t shards = threadsGiven && numThreads > 1 ? (size_t)numThreads : 1;
+        pdaModule.replayFlows(flowReplayPath, flowConcurrency > 0 ? (size_t)flowConcurrency : 1, shards);
+        pdaModule.generateFlowReport();
+        return pdaModule.getFlowMetrics().mismatches == 0 ? 0 : 1;
+    }
     try {
-        // Ensure output directory exists
-        std::filesystem::create_directories("output");
-        
-        if (scanMode) {
+        if (!scanDirRoot.empty()) {
+            // DIRECTORY SCAN MODE: parallel tree walk feeding the filename matcher
+            dfaModule.scanDirectory(scanDirRoot);
+        } else if (scanMode) {
             // SCAN MODE: Scan provided file paths
             // Build DFAs silently, then show file-by-file processing
             dfaModule.definePatterns();
             dfaModule.buildNFAs();          // Regex → NFA (Thompson's Construction)
             dfaModule.convertToDFAs();       // NFA → DFA (Subset Construction)
             dfaModule.minimizeDFAs();        // DFA minimization (Hopcroft's)
+            dfaModule.eliminateRedundantPatterns(); // Drop subsumed patterns from the hot set
             
             // Scan the provided files (this will show file-by-file details)
             if (dfaVerbose) {
@@ -102,6 +235,7 @@ int main(int argc, char* argv[]) {
                 // non-verbose scan: similar path but without transition prints
                 std::vector<bool> detected;
                 std::vector<std::string> matched;
+                std::vector<FileContentResult> content;
                 std::cout << "\n[INFO] Total files to scan: " << filePaths.size() << std::endl;
                 for (size_t i=0;i<filePaths.size();++i){
                     std::string fileName = filePaths[i];
@@ -111,8 +245,10 @@ int main(int argc, char* argv[]) {
                     std::string m; bool d = dfaModule.testFilenameWithDFA(fileName, m);
                     detected.push_back(d); matched.push_back(m);
                     std::cout << "  ✓ Result: " << (d?"SUSPICIOUS ("+m+")":"SAFE") << std::endl;
+                    content.push_back(dfaModule.scanFileContent(filePaths[i]));
+                    std::cout << "  → Content scan: " << DFAModule::describeContentResult(content.back()) << std::endl;
                 }
-                dfaModule.generateScanReport(filePaths, detected, matched);
+                dfaModule.generateScanReport(filePaths, detected, matched, content);
             }
         } else {
             // NORMAL MODE: Use dataset files with structured steps
@@ -148,6 +284,7 @@ int main(int argc, char* argv[]) {
             // 5. DFA Minimization (Hopcroft)
             std::cout << "5. DFA Minimization (Hopcroft)" << std::endl;
             dfaModule.minimizeDFAs();        
+            dfaModule.eliminateRedundantPatterns();
                 // Export regular grammars for each pattern (write once)
                 for (size_t i = 0; i < dfaModule.getDfaCount(); ++i) {
                     std::string path = "output/grammar_" + std::to_string(i) + ".txt";
@@ -226,6 +363,43 @@ int main(int argc, char* argv[]) {
     std::cout << std::endl;
     
     PDAModule pdaModule;
+    pdaModule.setDatasetStore(datasets);
+    VerdictStore verdictStore;
+    if (!verdictStorePath.empty()) {
+        uint64_t version = mix64(dfaModule.patternSetVersion() ^ PDAModule::GRAMMAR_REVISION ^ (strictHandshake ? 0x5354524943ULL : 0));
+        if (!verdictStore.open(verdictStorePath, version)) {
+            std::cerr << "[WARN] Ignoring unreadable verdict store (will be rewritten): " << verdictStorePath << std::endl;
+        }
+        std::cout << "[INFO] Verdict store: " << verdictStorePath << " (" << verdictStore.loadedRecords()
+                  << " current records, " << verdictStore.staleRecords() << " stale)" << std::endl;
+        pdaModule.setVerdictStore(&verdictStore);
+    }
+    // Content verdict for one record, reused from the store when the record and patterns are unchanged
+    auto scanRecordContent = [&](std::string_view id, std::string_view content, PacketRange sequence) {
+        if (!verdictStore.isOpen()) return dfaModule.scanContent(content);
+        uint64_t nameHash = VerdictStore::nameKey(id);
+        uint64_t contentHash = VerdictStore::contentKey(content, sequence);
+        const VerdictStore::Record* known = verdictStore.find(nameHash, contentHash);
+        if (known && (known->flags & VerdictStore::CONTENT_SCANNED)) return (known->flags & VerdictStore::CONTENT_MALICIOUS) != 0;
+        std::string matched;
+        bool malicious = dfaModule.testContentWithDFA(content, matched);
+        VerdictStore::Record& r = verdictStore.upsert(nameHash, contentHash);
+        r.flags |= VerdictStore::CONTENT_SCANNED;
+        r.match_mask = 0;
+        if (malicious) {
+            r.flags |= VerdictStore::CONTENT_MALICIOUS;
+            const auto& names = dfaModule.getContentPatternNames();
+            size_t k = (size_t)(std::find(names.begin(), names.end(), matched) - names.begin());
+            if (k < 32) r.match_mask = 1u << k;
+        }
+        return malicious;
+    };
+    auto flushVerdictStore = [&]() {
+        if (!verdictStore.isOpen()) return;
+        std::cout << "[STORE] Reused " << verdictStore.hits() << " record verdicts, evaluated "
+                  << verdictStore.misses() << " new/changed (PDA reused: " << pdaModule.getReusedVerdicts() << ")" << std::endl;
+        if (!verdictStore.flush()) std::cerr << "[WARN] Could not write verdict store: " << verdictStorePath << std::endl;
+    };
     try {
         // 1. Loading TCP Trace Dataset (TRICKS) then gating by DFA filename + content DFA
         std::cout << "1. Loading TCP Trace Dataset" << std::endl;
@@ -233,69 +407,54 @@ int main(int argc, char* argv[]) {
         pdaModule.loadDataset("archive/tcp_tricks.jsonl");
 
         // Compute intersection: suspicious filenames (DFA) ∩ content-malicious (DFA)
-        // Normalize identifiers to improve matching across datasets
-        auto toLower = [](std::string s){ std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c){return (char)std::tolower(c);}); return s; };
-        std::set<std::string> suspiciousSet;
-        for (auto id : suspiciousGlobal) { suspiciousSet.insert(toLower(id)); }
-        std::vector<TCPTrace> tricks = JSONParser::loadTCPDataset("archive/tcp_tricks.jsonl");
-        std::set<std::string> contentMalicious;
-        for (const auto& t : tricks) {
-            std::string normId = toLower(t.trace_id);
-            if (suspiciousSet.count(normId) == 0) continue; // filename must be suspicious first
-            if (dfaModule.scanContent(t.content)) {
-                contentMalicious.insert(normId);
-            }
+        // Identifiers are interned case-insensitively into dense handles shared by all datasets,
+        // so each stage's verdicts are a bitmap over handles and gating is a bitwise AND
+        DatasetStore::Views tricks = datasets->views("archive/tcp_tricks.jsonl");
+        DatasetStore::Handles tricksIds = datasets->handles("archive/tcp_tricks.jsonl");
+        // Also consider CSV dataset contents for gating (union with JSONL); already mapped when
+        // the filenames were staged, so this is a walk over views into the shared mapping
+        DatasetStore::Views csvTraces = datasets->views("archive/combined_with_tcp.csv");
+        DatasetStore::Handles csvIds = datasets->handles("archive/combined_with_tcp.csv");
+        std::vector<uint32_t> suspiciousIds;
+        suspiciousIds.reserve(suspiciousGlobal.size());
+        for (const auto& id : suspiciousGlobal) suspiciousIds.push_back(datasets->intern(id));
+        const TraceIdTable& ids = datasets->ids();
+
+        Bitmap suspicious(ids.size());
+        for (uint32_t h : suspiciousIds) suspicious.set(h);
+        Bitmap contentMalicious(ids.size());
+        for (size_t i = 0; i < tricks->size(); ++i) {
+            uint32_t h = (*tricksIds)[i];
+            if (!suspicious.test(h)) continue; // filename must be suspicious first
+            const TraceView& t = tricks->records()[i];
+            if (scanRecordContent(t.trace_id, t.content, t.sequence)) contentMalicious.set(h);
         }
-        // Also consider CSV dataset contents for gating (union with JSONL)
-        try {
-            std::ifstream csv("archive/combined_with_tcp.csv");
-            if (csv.is_open()) {
-                std::string header; std::getline(csv, header);
-                // Determine column indices dynamically
-                std::vector<std::string> cols; {
-                    std::stringstream hs(header); std::string col; while (std::getline(hs, col, ',')) cols.push_back(col);
-                }
-                auto findCol = [&](const std::vector<std::string>& names){
-                    for (size_t i=0;i<cols.size();++i){
-                        std::string c = toLower(cols[i]);
-                        for (const auto& n : names){ if (c == n) return (int)i; }
-                    }
-                    return -1;
-                };
-                int idCol = findCol({"trace_id","id","filename","file","name"});
-                int contentCol = findCol({"content","payload","text","body"});
-                std::string line;
-                while (std::getline(csv, line)){
-                    if (line.empty()) continue;
-                    std::vector<std::string> fields; {
-                        std::stringstream ls(line); std::string f; while (std::getline(ls, f, ',')) fields.push_back(f);
-                    }
-                    if (idCol>=0 && idCol<(int)fields.size() && contentCol>=0 && contentCol<(int)fields.size()){
-                        std::string id = toLower(fields[idCol]);
-                        std::string content = fields[contentCol];
-                        if (suspiciousSet.count(id)>0 && dfaModule.scanContent(content)){
-                            contentMalicious.insert(id);
-                        }
-                    }
-                }
-            }
-        } catch (...) {
-            // ignore CSV read errors
+        for (size_t i = 0; i < csvTraces->size(); ++i) {
+            uint32_t h = (*csvIds)[i];
+            const TraceView& t = csvTraces->records()[i];
+            if (t.content.empty() || !suspicious.test(h)) continue;
+            if (scanRecordContent(ids.name(h), t.content, PacketRange())) contentMalicious.set(h);
         }
+        Bitmap gate = suspicious;
+        gate &= contentMalicious;
+        const size_t suspiciousCount = suspicious.count();
+        const size_t gatedCount = gate.count();
 
         // Pipeline summary before gating
-        std::cout << "[PIPELINE] DFA filename suspicious: " << suspiciousSet.size()
-                  << ", Content-malicious (within suspicious): " << contentMalicious.size() << std::endl;
+        std::cout << "[PIPELINE] DFA filename suspicious: " << suspiciousCount
+                  << ", Content-malicious (within suspicious): " << gatedCount << std::endl;
+        dfaModule.printVerdictCacheStats();
 
         // If nothing to validate, skip PDA module entirely
-        if (contentMalicious.empty()) {
+        if (gatedCount == 0) {
             std::cout << "[INFO] No traces meet gating (filename suspicious AND content malicious). Skipping PDA." << std::endl;
+            flushVerdictStore();
             // Still export DOT/JSON for DFA modules below
             goto DOT_EXPORTS;
         }
 
         // Apply gating to PDA dataset
-        pdaModule.filterDatasetByTraceIds(contentMalicious);
+        pdaModule.filterDataset(gate);
 
         if (strictHandshake) {
             std::cout << "[INFO] Strict handshake-only CFG enabled" << std::endl;
@@ -336,10 +495,11 @@ int main(int argc, char* argv[]) {
 
         // Stage summary
         std::cout << "\n[PIPELINE SUMMARY]" << std::endl;
-        std::cout << "  Filename DFA flagged: " << suspiciousSet.size() << std::endl;
-        std::cout << "  Content DFA flagged within suspicious: " << contentMalicious.size() << std::endl;
+        std::cout << "  Filename DFA flagged: " << suspiciousCount << std::endl;
+        std::cout << "  Content DFA flagged within suspicious: " << gatedCount << std::endl;
         std::cout << "  PDA validated: " << pdaModule.getMetrics().total_traces << std::endl;
         std::cout << "  Final malicious (PDA rejected): " << finalMalicious.size() << std::endl;
+        flushVerdictStore();
         
         // 5. Stack Trace Examples
         std::cout << "5. Stack Trace Examples" << std::endl;
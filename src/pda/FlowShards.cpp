@@ -0,0 +1,134 @@
+/**
+ * FlowShards.cpp
+ * Flow-sharded multicore PDA validation: one shared-nothing flow table per worker core
+ */
+
+#include "FlowShards.h"
+
+namespace CS311 {
+
+FlowShards::FlowShards(const PDA& compiled, size_t shardCount, size_t maxFlowsPerShard, uint64_t idleTimeout,
+                       VerdictSink verdictSink, size_t ringCapacity)
+    : sink(std::move(verdictSink)) {
+    if (shardCount < 1) shardCount = 1;
+    shards.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        shards.push_back(std::make_unique<Shard>(compiled, maxFlowsPerShard, idleTimeout, ringCapacity));
+    }
+    for (auto& s : shards) {
+        Shard* shard = s.get();
+        shard->worker = std::thread([this, shard] { run(*shard); });
+    }
+}
+
+FlowShards::~FlowShards() {
+    finish();
+}
+
+void FlowShards::submit(const Packet& p) {
+    Shard& s = *shards[shardOf(p.key)];
+    while (!s.ring.tryPush(p)) std::this_thread::yield();
+}
+
+void FlowShards::process(Shard& s, const Packet& p) {
+    FlowStatus status = FlowStatus::IN_PROGRESS;
+    if (!s.untracked.empty() && s.untracked.count(p.key)) {
+        status = FlowStatus::UNTRACKED;
+    } else if (p.flags & FEED) {
+        status = s.flows.feed(s.pda, p.key, p.token, p.now);
+        s.local.packets++;
+        if (status == FlowStatus::UNTRACKED) s.untracked.insert(p.key);
+    } else {
+        status = s.flows.status(s.pda, p.key);
+    }
+    if (!(p.flags & CLOSE)) return;
+    s.local.traces++;
+    if (status == FlowStatus::ACCEPTED) s.local.accepted++;
+    else if (status == FlowStatus::UNTRACKED) s.local.untracked++;
+    else s.local.rejected++;
+    if (sink) sink(p.key, status);
+    if (status == FlowStatus::UNTRACKED) s.untracked.erase(p.key);
+    else s.flows.remove(p.key);
+}
+
+void FlowShards::publish(Shard& s) {
+    std::lock_guard<std::mutex> lock(s.published_m);
+    s.published = s.local;
+}
+
+void FlowShards::run(Shard& s) {
+    constexpr size_t BATCH = 256;
+    Packet batch[BATCH];
+    uint64_t next_publish = PUBLISH_INTERVAL;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (;;) {
+        size_t n = s.ring.tryPopBatch(batch, BATCH);
+        if (n == 0) {
+            if (stopping.load(std::memory_order_acquire)) {
+                // Everything was queued before the flag was set: drain once more and stop
+                while ((n = s.ring.tryPopBatch(batch, BATCH)) > 0) {
+                    for (size_t i = 0; i < n; ++i) process(s, batch[i]);
+                }
+                break;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < n; ++i) process(s, batch[i]);
+        if (s.local.packets >= next_publish) {
+            auto now = std::chrono::high_resolution_clock::now();
+            s.local.total_execution_time_ms = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count() / 1000.0;
+            publish(s);
+            next_publish = s.local.packets + PUBLISH_INTERVAL;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    s.local.total_execution_time_ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+    publish(s);
+}
+
+void FlowShards::finish() {
+    if (finished) return;
+    finished = true;
+    stopping.store(true, std::memory_order_release);
+    for (auto& s : shards) {
+        if (s->worker.joinable()) s->worker.join();
+    }
+}
+
+FlowMetrics FlowShards::metrics() const {
+    FlowMetrics m;
+    for (const auto& s : shards) {
+        std::lock_guard<std::mutex> lock(s->published_m);
+        const FlowMetrics& p = s->published;
+        m.traces += p.traces;
+        m.packets += p.packets;
+        m.accepted += p.accepted;
+        m.rejected += p.rejected;
+        m.untracked += p.untracked;
+        m.mismatches += p.mismatches;
+        // Workers run side by side: the slowest one bounds the elapsed time
+        m.total_execution_time_ms = std::max(m.total_execution_time_ms, p.total_execution_time_ms);
+    }
+    return m;
+}
+
+size_t FlowShards::peakFlows() const {
+    size_t n = 0;
+    for (const auto& s : shards) n += s->flows.peak();
+    return n;
+}
+
+uint64_t FlowShards::evictions() const {
+    uint64_t n = 0;
+    for (const auto& s : shards) n += s->flows.evictions();
+    return n;
+}
+
+size_t FlowShards::memoryBytes() const {
+    size_t n = 0;
+    for (const auto& s : shards) n += s->flows.memoryBytes() + s->ring.capacity() * sizeof(Packet);
+    return n;
+}
+
+} // namespace CS311
@@ -0,0 +1,96 @@
+/**
+ * FlowShards.h
+ * Flow-sharded multicore PDA validation: one shared-nothing flow table per worker core
+ */
+
+#ifndef FLOWSHARDS_H
+#define FLOWSHARDS_H
+
+#include "Utils.h"
+#include "FlowTable.h"
+#include "SPSCRing.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace CS311 {
+
+/**
+ * Each packet is routed by a hash of its flow key (RSS-style) to one of N workers, so every
+ * packet of a connection reaches the same worker and no flow state is ever shared. A worker
+ * owns its copy of the compiled PDA, its own FlowTable and FlowMetrics, and drains a
+ * single-producer/single-consumer ring fed by the one dispatching thread. Workers publish
+ * their metrics every PUBLISH_INTERVAL packets; metrics() merges the latest snapshots, so it
+ * can be polled while traffic is flowing.
+ *
+ * The shard is picked from the high half of mix64(key) while each FlowTable indexes with
+ * the low bits, so the keys one shard receives still spread over its whole table.
+ *
+ * A flow that finds its shard's table full is UNTRACKED until it closes: the rest of its
+ * packets are dropped rather than fed, so it is never validated from the middle of a trace,
+ * and it counts once as untracked when it closes.
+ *
+ * submit() and finish() must be called from one thread.
+ */
+class FlowShards {
+public:
+    enum PacketFlags : uint8_t { FEED = 1, CLOSE = 2 };
+    struct Packet {
+        uint64_t key;
+        uint64_t now;
+        PacketToken token;
+        uint8_t flags;        // FEED: step the flow with `token`; CLOSE: report and drop it
+    };
+    // Called on the worker's thread with the verdict of each closed flow
+    using VerdictSink = std::function<void(uint64_t flowKey, FlowStatus verdict)>;
+    static constexpr uint64_t PUBLISH_INTERVAL = 4096;
+
+    // `compiled` must be built (PDAModule::buildPDA); workers start right away
+    FlowShards(const PDA& compiled, size_t shards, size_t maxFlowsPerShard, uint64_t idleTimeout,
+               VerdictSink sink = VerdictSink(), size_t ringCapacity = 8192);
+    ~FlowShards();
+    FlowShards(const FlowShards&) = delete;
+    FlowShards& operator=(const FlowShards&) = delete;
+
+    size_t shardOf(uint64_t key) const { return (size_t)(((mix64(key) >> 32) * (uint64_t)shards.size()) >> 32); }
+    // Queue a packet for its flow's worker (waits while that worker's ring is full)
+    void submit(const Packet& p);
+    // Drain every ring and stop the workers; metrics() is final afterwards
+    void finish();
+
+    FlowMetrics metrics() const;
+    size_t size() const { return shards.size(); }
+    size_t peakFlows() const;        // sum of per-shard peaks (valid after finish())
+    uint64_t evictions() const;      // valid after finish()
+    size_t memoryBytes() const;      // valid after finish()
+
+private:
+    struct alignas(64) Shard {
+        SPSCRing<Packet> ring;
+        PDA pda;
+        FlowTable flows;
+        FlowMetrics local;
+        std::unordered_set<uint64_t> untracked;  // open flows that were refused a table slot
+        mutable std::mutex published_m;
+        FlowMetrics published;
+        std::thread worker;
+        Shard(const PDA& compiled, size_t maxFlows, uint64_t idleTimeout, size_t ringCapacity)
+            : ring(ringCapacity), pda(compiled), flows(maxFlows, idleTimeout) {}
+    };
+    std::vector<std::unique_ptr<Shard>> shards;
+    VerdictSink sink;
+    std::atomic<bool> stopping{false};
+    bool finished = false;
+
+    void run(Shard& s);
+    void process(Shard& s, const Packet& p);
+    void publish(Shard& s);
+};
+
+} // namespace CS311
+
+#endif // FLOWSHARDS_H
@@ -0,0 +1,145 @@
+/**
+ * FlowTable.cpp
+ * Open-addressing table of per-connection PDA configurations for incremental validation
+ */
+
+#include "FlowTable.h"
+
+namespace CS311 {
+
+static_assert(FlowTable::STACK_CAPACITY <= PDA::STACK_CAPACITY, "flow stacks must fit the PDA's");
+
+FlowTable::FlowTable(size_t maxFlows, uint64_t idleTimeout) {
+    configure(maxFlows, idleTimeout);
+}
+
+void FlowTable::configure(size_t maxFlows, uint64_t idleTimeout) {
+    max_flows = maxFlows < 1 ? 1 : maxFlows;
+    max_slots = 16;
+    while (max_slots < 2 * max_flows) max_slots *= 2;
+    idle_timeout = idleTimeout;
+    slots.clear();
+    slots.shrink_to_fit();
+    mask = 0;
+    count = 0;
+    peak_count = 0;
+    next_sweep = 0;
+    evicted = 0;
+}
+
+size_t FlowTable::slotOf(uint64_t key) const {
+    if (slots.empty()) return 0;
+    for (size_t i = home(key); slots[i].used; i = (i + 1) & mask) {
+        if (slots[i].key == key) return i;
+    }
+    return slots.size();
+}
+
+void FlowTable::grow() {
+    std::vector<Entry> old;
+    old.swap(slots);
+    size_t n = old.empty() ? 1024 : old.size() * 2;
+    if (n > max_slots) n = max_slots;
+    slots.assign(n, Entry());
+    mask = n - 1;
+    for (const Entry& e : old) {
+        if (!e.used) continue;
+        size_t i = home(e.key);
+        while (slots[i].used) i = (i + 1) & mask;
+        slots[i] = e;
+    }
+}
+
+void FlowTable::erase(size_t i) {
+    // Backward-shift deletion: move later members of the probe run into the hole
+    size_t hole = i;
+    for (size_t j = (i + 1) & mask; slots[j].used; j = (j + 1) & mask) {
+        size_t h = home(slots[j].key);
+        // Movable unless its home lies cyclically in (hole, j]
+        bool stays = hole <= j ? (hole < h && h <= j) : (hole < h || h <= j);
+        if (stays) continue;
+        slots[hole] = slots[j];
+        hole = j;
+    }
+    slots[hole].used = false;
+    count--;
+}
+
+size_t FlowTable::expire(uint64_t now) {
+    if (now < next_sweep) return 0;
+    size_t removed = 0;
+    uint64_t oldest = now;
+    for (size_t i = 0; i < slots.size();) {
+        const Entry& e = slots[i];
+        if (e.used && idle(e, now)) {
+            erase(i);  // re-examine slot i, which may now hold a shifted entry
+            removed++;
+            continue;
+        }
+        if (e.used && e.last_seen < oldest) oldest = e.last_seen;
+        i++;
+    }
+    evicted += removed;
+    next_sweep = oldest + idle_timeout + 1;
+    return removed;
+}
+
+FlowTable::Entry* FlowTable::acquire(uint64_t key, uint64_t now, uint8_t startState) {
+    size_t i = slotOf(key);
+    if (i < slots.size()) {
+        Entry& e = slots[i];
+        if (idle(e, now)) {
+            // Idle too long: whatever arrives now belongs to a new connection
+            e.state = startState;
+            e.depth = 0;
+            e.rejected = false;
+            evicted++;
+        }
+        e.last_seen = now;
+        return &e;
+    }
+    if (count >= max_flows && (expire(now) == 0 || count >= max_flows)) return nullptr;
+    if ((count + 1) * 2 > slots.size()) grow();
+    i = home(key);
+    while (slots[i].used) i = (i + 1) & mask;
+    Entry& e = slots[i];
+    e.key = key;
+    e.stack = 0;
+    e.last_seen = now;
+    e.state = startState;
+    e.depth = 0;
+    e.rejected = false;
+    e.used = true;
+    count++;
+    if (count > peak_count) peak_count = count;
+    return &e;
+}
+
+FlowStatus FlowTable::feed(const PDA& compiled, uint64_t key, PacketToken packet, uint64_t now) {
+    Entry* f = acquire(key, now, (uint8_t)compiled.start_state);
+    if (!f) return FlowStatus::UNTRACKED;
+    if (f->rejected) return FlowStatus::REJECTED;
+    const PDA::Step& s = compiled.table[PDA::index(f->state, packet, top(*f))];
+    pop(*f, s.pops);
+    if (!s.ok || (s.push != StackSymbol::BOTTOM && !push(*f, s.push))) {
+        f->rejected = true;
+        return FlowStatus::REJECTED;
+    }
+    f->state = s.next_state;
+    return f->depth == 0 && compiled.isAcceptingState(f->state) ? FlowStatus::ACCEPTED : FlowStatus::IN_PROGRESS;
+}
+
+FlowStatus FlowTable::status(const PDA& compiled, uint64_t key) const {
+    size_t i = slotOf(key);
+    if (i >= slots.size()) return FlowStatus::IN_PROGRESS;
+    const Entry& e = slots[i];
+    if (e.rejected) return FlowStatus::REJECTED;
+    return e.depth == 0 && compiled.isAcceptingState(e.state) ? FlowStatus::ACCEPTED : FlowStatus::IN_PROGRESS;
+}
+
+void FlowTable::remove(uint64_t key) {
+    size_t i = slotOf(key);
+    if (i < slots.size()) erase(i);
+}
+
+} // namespace CS311
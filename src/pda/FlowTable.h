@@ -0,0 +1,101 @@
+/**
+ * FlowTable.h
+ * Open-addressing table of per-connection PDA configurations for incremental validation
+ */
+
+#ifndef FLOWTABLE_H
+#define FLOWTABLE_H
+
+#include "Utils.h"
+#include <cstdint>
+#include <vector>
+
+namespace CS311 {
+
+// Verdict of a connection after one fed packet (PDAModule::feed)
+enum class FlowStatus : uint8_t {
+    IN_PROGRESS,  // handshake not complete
+    ACCEPTED,     // accepting state with an empty stack; DATA/FIN/ACK or a new handshake may follow
+    REJECTED,     // packet rejected by the PDA; the flow stays rejected until removed or idle
+    UNTRACKED     // table at its cap even after evicting idle flows; packet not validated
+};
+
+/**
+ * One slot per connection, keyed by a caller-supplied 64-bit flow key (e.g. a hash of the
+ * 5-tuple). An entry is only the compact PDA configuration: current state, stack depth and
+ * the stack itself packed two bits per StackSymbol, plus the time it last saw a packet. feed()
+ * steps an entry through a compiled PDA's transition table.
+ *
+ * Linear probing over a power-of-two slot array kept at most half full; erase shifts later
+ * entries of the probe run back, so there are no tombstones. The slot array grows with the
+ * number of live flows up to the size implied by maxFlows, which caps memory. A flow idle for
+ * longer than idleTimeout (in the caller's time unit) is restarted when its key shows up again,
+ * and idle flows are swept out when a new flow would exceed the cap.
+ */
+class FlowTable {
+public:
+    struct Entry {
+        uint64_t key;
+        uint64_t stack;       // symbol i above BOTTOM in bits 2i..2i+1
+        uint64_t last_seen;
+        uint8_t state;
+        uint8_t depth;
+        bool rejected;
+        bool used;
+    };
+    static constexpr int STACK_CAPACITY = 32;  // symbols that fit in Entry::stack
+
+    explicit FlowTable(size_t maxFlows = 1u << 20, uint64_t idleTimeout = 60000);
+    // Drops every flow
+    void configure(size_t maxFlows, uint64_t idleTimeout);
+
+    // Advance flow `key` by one packet through `compiled` (built, see PDA::stateCount())
+    FlowStatus feed(const PDA& compiled, uint64_t key, PacketToken packet, uint64_t now);
+    // Status of flow `key` without feeding it (an unknown flow is IN_PROGRESS)
+    FlowStatus status(const PDA& compiled, uint64_t key) const;
+
+    // Entry of `key`, (re)started in `startState` if absent or idle; nullptr when at the cap
+    Entry* acquire(uint64_t key, uint64_t now, uint8_t startState);
+    void remove(uint64_t key);
+    // Evict flows idle at `now`; returns how many
+    size_t expire(uint64_t now);
+
+    static StackSymbol top(const Entry& e) {
+        return e.depth == 0 ? StackSymbol::BOTTOM : (StackSymbol)((e.stack >> (2 * (e.depth - 1))) & 3);
+    }
+    static bool push(Entry& e, StackSymbol s) {
+        if (e.depth == STACK_CAPACITY) return false;
+        e.stack = (e.stack & ~(3ULL << (2 * e.depth))) | ((uint64_t)s << (2 * e.depth));
+        e.depth++;
+        return true;
+    }
+    static void pop(Entry& e, int n) { e.depth = n < e.depth ? (uint8_t)(e.depth - n) : 0; }
+
+    size_t size() const { return count; }
+    size_t maxFlows() const { return max_flows; }
+    uint64_t idleTimeout() const { return idle_timeout; }
+    size_t peak() const { return peak_count; }
+    uint64_t evictions() const { return evicted; }
+    size_t memoryBytes() const { return slots.capacity() * sizeof(Entry); }
+
+private:
+    std::vector<Entry> slots;
+    size_t mask = 0;
+    size_t count = 0;
+    size_t peak_count = 0;
+    size_t max_flows;
+    size_t max_slots;
+    uint64_t idle_timeout;
+    uint64_t next_sweep = 0;  // no flow can be idle before this time
+    uint64_t evicted = 0;
+
+    size_t home(uint64_t key) const { return (size_t)mix64(key) & mask; }
+    bool idle(const Entry& e, uint64_t now) const { return now > e.last_seen && now - e.last_seen > idle_timeout; }
+    size_t slotOf(uint64_t key) const;  // index of `key`, or slots.size()
+    void erase(size_t i);
+    void grow();
+};
+
+} // namespace CS311
+
+#endif // FLOWTABLE_H
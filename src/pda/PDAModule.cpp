@@ -4,6 +4,7 @@
  */
 
 #include "PDAModule.h"
+#include "FlowShards.h"
 #include <iostream>
 #include <fstream>
 #include <chrono>
@@ -15,28 +16,34 @@
 
 namespace CS311 {
 
-PDAModule::PDAModule() {}
+PDAModule::PDAModule() : datasets(std::make_shared<DatasetStore>()) {}
 
 void PDAModule::loadDataset(const std::string& filepath) {
-    // Load JSONL or CSV depending on extension
-    auto endsWith = [](const std::string& s, const std::string& suf){
-        if (s.size() < suf.size()) return false;
-        return std::equal(s.end()-suf.size(), s.end(), suf.begin(), suf.end(), [](char a,char b){return std::tolower(a)==std::tolower(b);});
-    };
-    if (endsWith(filepath, ".csv")) {
-        dataset = JSONParser::loadTCPDatasetCSV(filepath);
-    } else {
-        dataset = JSONParser::loadTCPDataset(filepath);
-    }
+    // JSONL or CSV depending on extension; parsed once per store
+    source = datasets->views(filepath);
+    synthesized.clear();
+    synthesized_packets.clear();
+    synthesized_tokens.clear();
+    synthesized_views.clear();
+    dataset.clear();
+    dataset.reserve(source->size());
+    for (const auto& t : source->records()) dataset.push_back(&t);
+    dataset_ids = *datasets->handles(filepath);
     metrics.total_traces = (int)dataset.size();
-    for (const auto& t : dataset) {
-        if (t.valid) metrics.valid_traces++;
+    for (const TraceView* t : dataset) {
+        if (t->valid) metrics.valid_traces++;
         else metrics.invalid_traces++;
     }
 }
 
 void PDAModule::synthesizeTracesForFilenames(const std::vector<std::string>& filenames, bool valid) {
     dataset.clear();
+    dataset_ids.clear();
+    source.reset();
+    synthesized.clear();
+    synthesized_packets.clear();
+    synthesized_tokens.clear();
+    synthesized_views.clear();
     metrics = PDAMetrics{};
     // Basic pools
     const std::vector<std::vector<std::string>> VALID_SEQS = {
@@ -51,7 +58,7 @@ void PDAModule::synthesizeTracesForFilenames(const std::vector<std::string>& fil
     std::uniform_int_distribution<size_t> dv(0, VALID_SEQS.size()-1);
     std::uniform_int_distribution<size_t> di(0, INVALID_SEQS.size()-1);
 
-    dataset.reserve(filenames.size());
+    synthesized.reserve(filenames.size());
     for (const auto& fn : filenames) {
         TCPTrace t;
         t.trace_id = fn;
@@ -66,7 +73,33 @@ void PDAModule::synthesizeTracesForFilenames(const std::vector<std::string>& fil
             t.description = "Synthetic invalid handshake for malicious filename";
             t.category = "Derived Malicious";
         }
-        dataset.push_back(std::move(t));
+        synthesized.push_back(std::move(t));
+    }
+    // Views over the owned traces; both arrays are sized up front so nothing moves afterwards
+    size_t packet_count = 0;
+    for (const auto& t : synthesized) packet_count += t.sequence.size();
+    synthesized_packets.reserve(packet_count);
+    synthesized_tokens.reserve(packet_count);
+    synthesized_views.reserve(synthesized.size());
+    for (const auto& t : synthesized) {
+        size_t first = synthesized_packets.size();
+        for (const auto& packet : t.sequence) {
+            synthesized_packets.emplace_back(packet);
+            synthesized_tokens.push_back(packetToken(packet));
+        }
+        TraceView v;
+        v.trace_id = t.trace_id;
+        v.sequence = PacketRange(synthesized_packets.data() + first, synthesized_packets.data() + synthesized_packets.size(),
+                                 synthesized_tokens.data() + first);
+        v.valid = t.valid;
+        v.description = t.description;
+        v.category = t.category;
+        v.content = t.content;
+        synthesized_views.push_back(v);
+    }
+    for (const auto& v : synthesized_views) {
+        dataset.push_back(&v);
+        dataset_ids.push_back(datasets->intern(v.trace_id));
     }
     metrics.total_traces = (int)dataset.size();
     metrics.valid_traces = valid ? (int)dataset.size() : 0;
@@ -107,6 +140,7 @@ void PDAModule::buildPDA() {
     
     pda.start_state = Q_START;
     pda.accepting_states.insert(Q_ACCEPT);
+    compileTransitions();
     
     std::cout << "\n[PDA STRUCTURE]" << std::endl;
     std::cout << "  States: " << pda.states.size() << std::endl;
@@ -158,146 +192,354 @@ void PDAModule::exportPDAConstruction(const std::string& outPath) {
     out.close();
 }
 
-bool PDAModule::processPacket(const std::string& packet, std::vector<std::string>& operations) {
-    std::string top = pda.peek();
-    int current = pda.current_state;
-    
-    // SOUNDNESS CHECK: Verify current state is in Q
-    bool state_valid = false;
-    for (const auto& s : pda.states) {
-        if (s.id == current) {
-            state_valid = true;
-            break;
+namespace {
+// Operation descriptions indexed by PDA::Step::note
+enum StepNote : uint8_t {
+    NOTE_PUSH_SYN, NOTE_PUSH_SYNACK, NOTE_POP_HANDSHAKE, NOTE_ACCEPT_DATA, NOTE_ACCEPT_FIN,
+    NOTE_ACCEPT_ACK, NOTE_NEW_HANDSHAKE, NOTE_INVALID_PACKET, NOTE_RST, NOTE_PRECONDITION,
+    NOTE_STACK_VIOLATION, NOTE_INVALID_TRANSITION, NOTE_STACK_OVERFLOW, NOTE_COUNT
+};
+const char* const STEP_NOTES[NOTE_COUNT] = {
+    "PUSH(SYN) → q1",
+    "PUSH(SYN-ACK) → q2",
+    "POP(SYN-ACK), POP(SYN) → q3",
+    "ACCEPT DATA → q3",
+    "ACCEPT FIN → q3",
+    "ACCEPT ACK → q3",
+    "NEW HANDSHAKE: PUSH(SYN) → q1",
+    "ERROR: Invalid packet",
+    "ERROR: RST received",
+    "[PRECONDITION MISSING] SYN before SYN-ACK",
+    "[STACK VIOLATION] ACK without SYN-ACK",
+    "ERROR: Invalid transition",
+    "[INVARIANT VIOLATION] Stack depth exceeds capacity"
+};
+
+PDA::Step accept(int next, uint8_t note, StackSymbol push = StackSymbol::BOTTOM, uint8_t pops = 0) {
+    PDA::Step s;
+    s.next_state = (uint8_t)next;
+    s.pops = pops;
+    s.push = push;
+    s.note = note;
+    s.ok = true;
+    return s;
+}
+
+PDA::Step reject(uint8_t note) {
+    PDA::Step s;
+    s.next_state = Q_ERROR;
+    s.note = note;
+    return s;
+}
+} // namespace
+
+// Transition rules of the handshake CFG for one (state, packet, stack top) combination
+PDA::Step PDAModule::rule(int state, PacketToken packet, StackSymbol top) const {
+    // State 0: Expecting SYN (Start of handshake)
+    if (state == Q_START && packet == PacketToken::SYN)
+        return accept(Q_SYN_RECEIVED, NOTE_PUSH_SYN, StackSymbol::SYN);
+    // State 1: Expecting SYN-ACK (Server response)
+    if (state == Q_SYN_RECEIVED && packet == PacketToken::SYN_ACK && top == StackSymbol::SYN)
+        return accept(Q_SYNACK_RECEIVED, NOTE_PUSH_SYNACK, StackSymbol::SYN_ACK);
+    // State 2: Expecting ACK (Client acknowledgment); pops SYN-ACK and SYN
+    if (state == Q_SYNACK_RECEIVED && packet == PacketToken::ACK && top == StackSymbol::SYN_ACK)
+        return accept(Q_ACCEPT, NOTE_POP_HANDSHAKE, StackSymbol::BOTTOM, 2);
+    // State 3: After handshake - allow data transfer, or a new handshake
+    if (state == Q_ACCEPT) {
+        if (!strictHandshakeOnly) {
+            if (packet == PacketToken::DATA) return accept(Q_ACCEPT, NOTE_ACCEPT_DATA);
+            if (packet == PacketToken::FIN) return accept(Q_ACCEPT, NOTE_ACCEPT_FIN);
+            if (packet == PacketToken::ACK) return accept(Q_ACCEPT, NOTE_ACCEPT_ACK);
+            if (packet == PacketToken::SYN) return accept(Q_SYN_RECEIVED, NOTE_NEW_HANDSHAKE, StackSymbol::SYN);
         }
+        return reject(NOTE_INVALID_PACKET);
     }
-    if (!state_valid) {
-        std::cerr << "[INVARIANT VIOLATION] Current state " << current 
-                 << " not in Q. Valid states: ";
-        for (const auto& s : pda.states) {
-            std::cerr << s.id << " ";
+    // RST always causes error
+    if (packet == PacketToken::RST) return reject(NOTE_RST);
+    // Invalid transition with formal logs
+    if (state == Q_SYN_RECEIVED && packet == PacketToken::ACK) return reject(NOTE_PRECONDITION);
+    if (state == Q_SYNACK_RECEIVED && packet == PacketToken::ACK && top != StackSymbol::SYN_ACK) return reject(NOTE_STACK_VIOLATION);
+    return reject(NOTE_INVALID_TRANSITION);
+}
+
+void PDAModule::compileTransitions() {
+    int states = 0;
+    for (const auto& st : pda.states) states = std::max(states, st.id + 1);
+    pda.accepting_mask = 0;
+    for (int q : pda.accepting_states) {
+        if (q >= 0 && q < 64) pda.accepting_mask |= 1ULL << q;
+    }
+    pda.table.assign((size_t)states * PDA::TOKENS * PDA::SYMBOLS, PDA::Step());
+    for (int q = 0; q < states; ++q) {
+        for (size_t t = 0; t < PDA::TOKENS; ++t) {
+            for (size_t top = 0; top < PDA::SYMBOLS; ++top) {
+                pda.table[PDA::index(q, (PacketToken)t, (StackSymbol)top)] = rule(q, (PacketToken)t, (StackSymbol)top);
+            }
         }
-        std::cerr << std::endl;
+    }
+}
+
+void PDAModule::setStrictHandshake(bool strict) {
+    strictHandshakeOnly = strict;
+    if (!pda.table.empty()) compileTransitions();
+}
+
+bool PDAModule::step(PacketToken packet, uint8_t& note) {
+    const PDA::Step& s = pda.table[PDA::index(pda.current_state, packet, pda.peek())];
+    pda.pop(s.pops);
+    // SOUNDNESS CHECK: Stack discipline - the fixed capacity bounds the depth
+    if (s.push != StackSymbol::BOTTOM && !pda.push(s.push)) {
+        note = NOTE_STACK_OVERFLOW;
         pda.current_state = Q_ERROR;
         return false;
     }
-    
-    // State 0: Expecting SYN (Start of handshake)
-    if (current == Q_START && packet == "SYN") {
-        pda.push("SYN");
-        pda.current_state = Q_SYN_RECEIVED;
-        operations.push_back("PUSH(SYN) → q1");
-        return true;
+    note = s.note;
+    pda.current_state = s.next_state;
+    return s.ok;
+}
+
+bool PDAModule::validateSequence(PacketRange sequence) {
+    pda.reset();
+    // Every next state comes from the table, so only the start state needs checking
+    if (pda.start_state >= pda.stateCount()) return false;
+
+    // Tokens interned at load; ranges without them (none today) are tokenized on the fly
+    const PacketToken* tokens = sequence.tokens();
+    uint8_t note;
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        PacketToken packet = tokens ? tokens[i] : packetToken(sequence.begin()[i]);
+        if (!step(packet, note)) return false;
     }
-    
-    // State 1: Expecting SYN-ACK (Server response)
-    else if (current == Q_SYN_RECEIVED && packet == "SYN-ACK" && top == "SYN") {
-        pda.push("SYN-ACK");
-        pda.current_state = Q_SYNACK_RECEIVED;
-        operations.push_back("PUSH(SYN-ACK) → q2");
-        return true;
+    // Accept if in accepting state with empty stack
+    return pda.isAccepting();
+}
+
+PDAExplanation PDAModule::explain(PacketRange sequence) {
+    PDAExplanation e;
+    pda.reset();
+    // SOUNDNESS CHECK: the start state must be a row of the compiled table (a state of Q)
+    if (pda.start_state >= pda.stateCount()) {
+        e.violations.push_back("Current state " + std::to_string(pda.start_state) + " not in Q (PDA not built)");
+        e.final_state = Q_ERROR;
+        return e;
     }
-    
-    // State 2: Expecting ACK (Client acknowledgment)
-    else if (current == Q_SYNACK_RECEIVED && packet == "ACK" && top == "SYN-ACK") {
-        pda.pop();  // Pop SYN-ACK
-        pda.pop();  // Pop SYN
-        pda.current_state = Q_ACCEPT;
-        operations.push_back("POP(SYN-ACK), POP(SYN) → q3");
-        return true;
+    const PacketToken* tokens = sequence.tokens();
+    e.steps.reserve(sequence.size());
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        PDAExplanation::Step s;
+        s.packet.assign(sequence.begin()[i]);
+        s.from_state = pda.current_state;
+        uint8_t note;
+        s.ok = step(tokens ? tokens[i] : packetToken(sequence.begin()[i]), note);
+        s.to_state = pda.current_state;
+        s.stack_depth = pda.getStackDepth();
+        s.operation = STEP_NOTES[note];
+        if (note == NOTE_STACK_OVERFLOW) e.violations.push_back(s.operation);
+        e.steps.push_back(std::move(s));
     }
-    
-    // State 3: After handshake - allow data transfer
-    else if (current == Q_ACCEPT) {
-        if (!strictHandshakeOnly) {
-            if (packet == "DATA") {
-                operations.push_back("ACCEPT DATA → q3");
-                return true;
+    e.final_state = pda.current_state;
+    e.stack_depth = pda.getStackDepth();
+    e.accepted = pda.isAccepting();
+    // SOUNDNESS CHECK: Acceptance condition - state-based AND empty stack
+    if (pda.isAcceptingState(pda.current_state) && !e.accepted) {
+        e.violations.push_back("In accepting state but stack not empty. Stack depth: " + std::to_string(e.stack_depth));
+    }
+    return e;
+}
+
+PDAExplanation PDAModule::explain(const std::vector<std::string>& sequence) {
+    std::vector<std::string_view> packets(sequence.begin(), sequence.end());
+    return explain(PacketRange(packets.data(), packets.data() + packets.size()));
+}
+
+FlowStatus PDAModule::feed(uint64_t flowKey, PacketToken packet, uint64_t now) {
+    if (pda.start_state >= pda.stateCount()) return FlowStatus::UNTRACKED;
+    return flows.feed(pda, flowKey, packet, now);
+}
+
+void PDAModule::replayFlows(const std::string& filepath, size_t concurrent, size_t shards) {
+    DatasetStore::Views source = datasets->views(filepath);
+    const std::vector<TraceView>& records = source->records();
+    if (concurrent < 1) concurrent = 1;
+    std::cout << "[INFO] Replaying " << records.size() << " traces as interleaved flows ("
+              << concurrent << " concurrent";
+    if (shards > 1) std::cout << ", " << shards << " worker shards";
+    std::cout << ")..." << std::endl;
+    if (shards > 1) {
+        replayFlowsSharded(records, concurrent, shards);
+        return;
+    }
+
+    struct Active {
+        size_t record;
+        size_t next;          // next packet to feed
+        FlowStatus status;
+    };
+    std::vector<Active> active;
+    active.reserve(std::min(concurrent, records.size()));
+    size_t next_record = 0;
+    uint64_t now = 0;         // logical clock: one tick per round-robin pass
+    flow_metrics = FlowMetrics{};
+    auto start = std::chrono::high_resolution_clock::now();
+
+    while (next_record < records.size() && active.size() < concurrent) active.push_back({next_record++, 0, FlowStatus::IN_PROGRESS});
+    // Round-robin: one packet per open connection per pass, so flows interleave like live traffic
+    // Every open flow gets a packet each pass, so no live flow is ever more than one tick idle
+    // and the idle timeout only reclaims flows that were never closed
+    while (!active.empty()) {
+        ++now;
+        for (size_t k = 0; k < active.size();) {
+            Active& a = active[k];
+            const TraceView& t = records[a.record];
+            uint64_t key = (uint64_t)a.record;
+            bool done = a.next == t.sequence.size();
+            if (!done) {
+                const PacketToken* tokens = t.sequence.tokens();
+                a.status = feed(key, tokens ? tokens[a.next] : packetToken(t.sequence.begin()[a.next]), now);
+                a.next++;
+                flow_metrics.packets++;
+                done = a.status == FlowStatus::REJECTED || a.status == FlowStatus::UNTRACKED;
+                if (!done) {
+                    k++;
+                    continue;
+                }
             }
-            else if (packet == "FIN") {
-                operations.push_back("ACCEPT FIN → q3");
-                return true;
+            flow_metrics.traces++;
+            if (a.status == FlowStatus::UNTRACKED) {
+                flow_metrics.untracked++;
+            } else {
+                bool accepted = a.status == FlowStatus::ACCEPTED;
+                if (accepted) flow_metrics.accepted++; else flow_metrics.rejected++;
+                int depth = 0;
+                if (validateTrace(t, depth) != accepted) flow_metrics.mismatches++;
             }
-            else if (packet == "ACK") {
-                operations.push_back("ACCEPT ACK → q3");
-                return true;
+            closeFlow(key);
+            if (next_record < records.size()) {
+                a = Active{next_record++, 0, FlowStatus::IN_PROGRESS};
+                k++;
+            } else {
+                a = active.back();
+                active.pop_back();
             }
         }
-        // Allow new handshake after completion
-        if (!strictHandshakeOnly && packet == "SYN") {
-            pda.push("SYN");
-            pda.current_state = Q_SYN_RECEIVED;
-            operations.push_back("NEW HANDSHAKE: PUSH(SYN) → q1");
-            return true;
-        }
-        else {
-            pda.current_state = Q_ERROR;
-            operations.push_back("ERROR: Invalid packet");
-            return false;
-        }
     }
-    
-    // RST always causes error
-    else if (packet == "RST") {
-        pda.current_state = Q_ERROR;
-        operations.push_back("ERROR: RST received");
-        return false;
-    }
-    
-    // Invalid transition with formal logs
-    if (current == Q_SYN_RECEIVED && packet == "ACK") {
-        operations.push_back("[PRECONDITION MISSING] SYN before SYN-ACK");
-    } else if (current == Q_SYNACK_RECEIVED && packet == "ACK" && top != "SYN-ACK") {
-        operations.push_back("[STACK VIOLATION] ACK without SYN-ACK");
-    } else {
-        operations.push_back("ERROR: Invalid transition");
-    }
-    pda.current_state = Q_ERROR;
-    return false;
+
+    auto end = std::chrono::high_resolution_clock::now();
+    flow_metrics.total_execution_time_ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+    flow_metrics.evictions = flows.evictions();
+    flow_metrics.peak_flows = flows.peak();
+    flow_metrics.memory_bytes = flows.memoryBytes();
+    std::cout << "[SUCCESS] Fed " << flow_metrics.packets << " packets in " << flow_metrics.total_execution_time_ms << " ms" << std::endl;
 }
 
-bool PDAModule::validateSequence(const std::vector<std::string>& sequence) {
-    pda.reset();
-    
-    for (const auto& packet : sequence) {
-        std::vector<std::string> ops;
-        if (!processPacket(packet, ops)) {
-            return false;
-        }
-        
-        // SOUNDNESS CHECK: Stack discipline - verify stack depth is reasonable
-        int stack_depth = pda.getStackDepth();
-        if (stack_depth < 0) {
-            std::cerr << "[INVARIANT VIOLATION] Stack depth negative: " << stack_depth << std::endl;
-            return false;
-        }
-        if (stack_depth > 100) { // Reasonable upper bound
-            std::cerr << "[INVARIANT VIOLATION] Stack depth exceeds reasonable limit: " << stack_depth << std::endl;
-            return false;
+void PDAModule::replayFlowsSharded(const std::vector<TraceView>& records, size_t concurrent, size_t shards) {
+    // Verdicts land here from the worker threads; each flow (record) is closed exactly once
+    std::vector<uint8_t> verdicts(records.size(), (uint8_t)FlowStatus::UNTRACKED);
+    size_t per_shard = (flows.maxFlows() + shards - 1) / shards;
+    auto start = std::chrono::high_resolution_clock::now();
+    FlowShards workers(pda, shards, per_shard, flows.idleTimeout(),
+                       [&verdicts](uint64_t key, FlowStatus v) { verdicts[(size_t)key] = (uint8_t)v; });
+
+    // Same round-robin interleaving as the single-table replay, but the dispatcher never waits
+    // for a verdict: rejections are sticky, so the rest of a rejected trace is simply absorbed
+    struct Active {
+        size_t record;
+        size_t next;
+    };
+    std::vector<Active> active;
+    active.reserve(std::min(concurrent, records.size()));
+    size_t next_record = 0;
+    uint64_t now = 0;         // one tick per round-robin pass, as in replayFlows
+    while (next_record < records.size() && active.size() < concurrent) active.push_back({next_record++, 0});
+    while (!active.empty()) {
+        ++now;
+        for (size_t k = 0; k < active.size();) {
+            Active& a = active[k];
+            const TraceView& t = records[a.record];
+            FlowShards::Packet p;
+            p.key = (uint64_t)a.record;
+            p.now = now;
+            p.flags = FlowShards::CLOSE;
+            p.token = PacketToken::OTHER;
+            if (a.next < t.sequence.size()) {
+                const PacketToken* tokens = t.sequence.tokens();
+                p.token = tokens ? tokens[a.next] : packetToken(t.sequence.begin()[a.next]);
+                p.flags = a.next + 1 == t.sequence.size() ? (FlowShards::FEED | FlowShards::CLOSE) : FlowShards::FEED;
+                a.next++;
+            }
+            workers.submit(p);
+            if (!(p.flags & FlowShards::CLOSE)) {
+                k++;
+            } else if (next_record < records.size()) {
+                a = Active{next_record++, 0};
+                k++;
+            } else {
+                a = active.back();
+                active.pop_back();
+            }
         }
     }
-    
-    // SOUNDNESS CHECK: Acceptance condition - state-based AND empty stack
-    bool in_accepting_state = pda.accepting_states.count(pda.current_state) > 0;
-    bool stack_empty = pda.pda_stack.size() == 1; // Only BOTTOM marker
-    
-    if (in_accepting_state && !stack_empty) {
-        std::cerr << "[INVARIANT VIOLATION] Missing precondition: In accepting state but stack not empty. "
-                 << "Stack depth: " << pda.getStackDepth() << std::endl;
+    workers.finish();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    flow_metrics = workers.metrics();
+    flow_metrics.total_execution_time_ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+    flow_metrics.evictions = workers.evictions();
+    flow_metrics.peak_flows = workers.peakFlows();
+    flow_metrics.memory_bytes = workers.memoryBytes();
+    flow_metrics.shards = workers.size();
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (verdicts[i] == (uint8_t)FlowStatus::UNTRACKED) continue;
+        int depth = 0;
+        if (validateTrace(records[i], depth) != (verdicts[i] == (uint8_t)FlowStatus::ACCEPTED)) flow_metrics.mismatches++;
     }
-    if (!in_accepting_state && stack_empty) {
-        // This is valid - not accepting yet
+    std::cout << "[SUCCESS] Fed " << flow_metrics.packets << " packets in " << flow_metrics.total_execution_time_ms << " ms" << std::endl;
+}
+
+void PDAModule::generateFlowReport() {
+    const FlowMetrics& m = flow_metrics;
+    std::cout << "\n╔═══════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║          INCREMENTAL FLOW VALIDATION - RESULTS            ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════════╝" << std::endl;
+    std::cout << "  Flows completed:        " << m.traces << std::endl;
+    std::cout << "  Packets fed:            " << m.packets << std::endl;
+    std::cout << "  Accepted:               " << m.accepted << std::endl;
+    std::cout << "  Rejected:               " << m.rejected << std::endl;
+    std::cout << "  Untracked (table full): " << m.untracked << std::endl;
+    std::cout << "  " << (m.mismatches == 0 ? "✓" : "✗") << " Verdicts matching batch validation: "
+              << (m.traces - m.untracked - m.mismatches) << " / " << (m.traces - m.untracked) << std::endl;
+    std::cout << "  Worker shards:          " << m.shards << std::endl;
+    std::cout << "  Peak open flows:        " << m.peak_flows << std::endl;
+    std::cout << "  Idle evictions:         " << m.evictions << std::endl;
+    std::cout << "  Flow table memory:      " << m.memory_bytes / 1024 << " KB" << std::endl;
+    if (m.packets > 0 && m.total_execution_time_ms > 0) {
+        std::cout << "  Time per packet:        " << (m.total_execution_time_ms * 1000.0 / m.packets) << " μs" << std::endl;
+        std::cout << "  Throughput:             " << (m.packets / m.total_execution_time_ms / 1000.0) << " M packets/s" << std::endl;
     }
-    
-    // Accept if in accepting state with empty stack
-    bool result = pda.isAccepting();
-    
-    // Log acceptance condition details if verbose
-    if (!result && in_accepting_state) {
-        std::cerr << "[INVARIANT VIOLATION] In accepting state but stack not empty. "
-                 << "Stack depth: " << pda.getStackDepth() << std::endl;
+    std::cout << std::endl;
+}
+
+bool PDAModule::validateTrace(const TraceView& t, int& stack_depth) {
+    if (!verdict_store) {
+        bool ok = validateSequence(t.sequence);
+        stack_depth = pda.getStackDepth();
+        return ok;
     }
-    
-    return result;
+    uint64_t nameHash = VerdictStore::nameKey(t.trace_id);
+    uint64_t contentHash = VerdictStore::contentKey(t.content, t.sequence);
+    const VerdictStore::Record* known = verdict_store->find(nameHash, contentHash);
+    if (known && (known->flags & VerdictStore::PDA_EVALUATED)) {
+        reused_verdicts++;
+        stack_depth = known->stack_depth;
+        return (known->flags & VerdictStore::PDA_ACCEPTED) != 0;
+    }
+    bool ok = validateSequence(t.sequence);
+    stack_depth = pda.getStackDepth();
+    VerdictStore::Record& r = verdict_store->upsert(nameHash, contentHash);
+    r.flags |= VerdictStore::PDA_EVALUATED;
+    if (ok) r.flags |= VerdictStore::PDA_ACCEPTED; else r.flags &= (uint16_t)~VerdictStore::PDA_ACCEPTED;
+    r.stack_depth = (uint16_t)std::max(0, std::min(stack_depth, 0xFFFF));
+    return ok;
 }
 
 void PDAModule::testAllTraces() {
@@ -319,9 +561,10 @@ void PDAModule::testAllTraces() {
     int total_depth = 0;
     std::vector<std::string> failed_traces;
     
-    for (const auto& t : dataset) {
-        bool result = validateSequence(t.sequence);
-        int depth = pda.getStackDepth();
+    for (const TraceView* p : dataset) {
+        const TraceView& t = *p;
+        int depth = 0;
+        bool result = validateTrace(t, depth);
         
         if (depth > metrics.max_stack_depth) {
             metrics.max_stack_depth = depth;
@@ -336,11 +579,11 @@ void PDAModule::testAllTraces() {
         }
         else if (result && !t.valid) {
             metrics.false_positives++;
-            failed_traces.push_back("FP: " + t.trace_id);
+            failed_traces.push_back("FP: " + std::string(t.trace_id));
         }
         else if (!result && t.valid) {
             metrics.false_negatives++;
-            failed_traces.push_back("FN: " + t.trace_id);
+            failed_traces.push_back("FN: " + std::string(t.trace_id));
         }
     }
     
@@ -371,27 +614,26 @@ void PDAModule::testAllTraces() {
     std::cout << std::endl;
 }
 
-void PDAModule::filterDatasetByTraceIds(const std::set<std::string>& ids) {
-    if (ids.empty()) return;
-    std::vector<TCPTrace> filtered;
-    filtered.reserve(dataset.size());
-    for (const auto& t : dataset) {
-        if (ids.count(t.trace_id) > 0) {
-            filtered.push_back(t);
-        }
+void PDAModule::filterDataset(const Bitmap& keep) {
+    // Compaction in place: one bit test per trace, no id comparisons
+    size_t kept = 0;
+    for (size_t i = 0; i < dataset.size(); ++i) {
+        if (!keep.test(dataset_ids[i])) continue;
+        dataset[kept] = dataset[i];
+        dataset_ids[kept] = dataset_ids[i];
+        kept++;
     }
-    dataset.swap(filtered);
+    dataset.resize(kept);
+    dataset_ids.resize(kept);
     metrics.total_traces = (int)dataset.size();
     metrics.valid_traces = 0;
     metrics.invalid_traces = 0;
-    for (const auto& t : dataset) {
-        if (t.valid) metrics.valid_traces++; else metrics.invalid_traces++;
+    for (const TraceView* t : dataset) {
+        if (t->valid) metrics.valid_traces++; else metrics.invalid_traces++;
     }
 }
 
 void PDAModule::showStackOperations(const std::vector<std::string>& sequence) {
-    pda.reset();
-    
     std::cout << "\n╔════════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║  STACK TRACE VISUALIZATION                             ║" << std::endl;
     std::cout << "╚════════════════════════════════════════════════════════╝" << std::endl;
@@ -406,22 +648,23 @@ void PDAModule::showStackOperations(const std::vector<std::string>& sequence) {
     std::cout << "\nStep-by-step execution:" << std::endl;
     std::cout << "  Initial: State=q0, Stack=[BOTTOM]" << std::endl;
     
-    for (size_t i = 0; i < sequence.size(); ++i) {
-        int state_before = pda.current_state;
-        std::vector<std::string> ops;
-        bool ok = processPacket(sequence[i], ops);
-        
-        std::cout << "  Step " << (i+1) << ": Input='" << sequence[i] << "'" << std::endl;
-        std::cout << "         State: q" << state_before << " → q" << pda.current_state << std::endl;
-        std::cout << "         Operation: " << (ops.empty() ? "none" : ops[0]) << std::endl;
-        std::cout << "         Stack depth: " << pda.getStackDepth();
-        if (!ok) std::cout << " [ERROR]";
+    PDAExplanation e = explain(sequence);
+    for (size_t i = 0; i < e.steps.size(); ++i) {
+        const PDAExplanation::Step& s = e.steps[i];
+        std::cout << "  Step " << (i+1) << ": Input='" << s.packet << "'" << std::endl;
+        std::cout << "         State: q" << s.from_state << " → q" << s.to_state << std::endl;
+        std::cout << "         Operation: " << s.operation << std::endl;
+        std::cout << "         Stack depth: " << s.stack_depth;
+        if (!s.ok) std::cout << " [ERROR]";
         std::cout << std::endl;
     }
+    for (const auto& v : e.violations) {
+        std::cerr << "[INVARIANT VIOLATION] " << v << std::endl;
+    }
     
-    std::cout << "\n  Final state: q" << pda.current_state << std::endl;
-    std::cout << "  Stack depth: " << pda.getStackDepth() << std::endl;
-    std::cout << "  Result: " << (pda.isAccepting() ? "✓ VALID" : "✗ INVALID") << std::endl;
+    std::cout << "\n  Final state: q" << e.final_state << std::endl;
+    std::cout << "  Stack depth: " << e.stack_depth << std::endl;
+    std::cout << "  Result: " << (e.accepted ? "✓ VALID" : "✗ INVALID") << std::endl;
     std::cout << std::endl;
 }
 
@@ -442,7 +685,7 @@ void PDAModule::generateReport() {
             std::shuffle(idx.begin(), idx.end(), gen);
             size_t sample_count = 0;
             for (size_t j=0; j<idx.size() && sample_count<K; ++j) {
-                const auto& t = dataset[idx[j]];
+                const TraceView& t = *dataset[idx[j]];
                 pda.reset();
                 bool result = validateSequence(t.sequence);
                 std::string validation = result ? "VALID" : "INVALID";
@@ -452,12 +695,12 @@ void PDAModule::generateReport() {
                 } else if (result && !t.valid) {
                     reason = " (unexpected acceptance)";
                 } else if (!result && !t.valid && !t.description.empty()) {
-                    reason = " (" + t.description + ")";
+                    reason = " (" + std::string(t.description) + ")";
                 }
                 std::ostringstream id;
                 id << "Trace_" << std::setw(3) << std::setfill('0') << (sample_count+1);
                 std::cout << "[" << id.str() << "] "
-                          << (t.trace_id.empty()? std::string("(no-id)") : t.trace_id)
+                          << (t.trace_id.empty()? std::string_view("(no-id)") : t.trace_id)
                           << ": " << validation << reason << std::endl;
                 sample_count++;
             }
@@ -597,10 +840,11 @@ namespace CS311 {
 std::vector<std::string> PDAModule::collectRejectedIds() {
     std::vector<std::string> rejected;
     // Validate each trace in the current dataset and collect those the PDA rejects
-    for (const auto& t : dataset) {
-        bool ok = validateSequence(t.sequence);
+    for (const TraceView* t : dataset) {
+        int depth = 0;
+        bool ok = validateTrace(*t, depth);
         if (!ok) {
-            rejected.push_back(t.trace_id);
+            rejected.emplace_back(t->trace_id);
         }
     }
     return rejected;
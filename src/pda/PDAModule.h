@@ -8,8 +8,13 @@
 
 #include "Utils.h"
 #include "JSONParser.h"
+#include "VerdictStore.h"
+#include "DatasetStore.h"
+#include "FlowTable.h"
 #include <vector>
 #include <string>
+#include <string_view>
+#include <memory>
 
 namespace CS311 {
 
@@ -22,22 +27,67 @@ enum PDAStates {
     Q_ERROR = 4
 };
 
+// Step-by-step account of one trace replayed through the PDA (PDAModule::explain)
+struct PDAExplanation {
+    struct Step {
+        std::string packet;
+        int from_state;
+        int to_state;
+        int stack_depth;
+        bool ok;
+        std::string operation;
+        Step() : from_state(0), to_state(0), stack_depth(0), ok(false) {}
+    };
+    std::vector<Step> steps;           // every packet, including those after the first error
+    int final_state;
+    int stack_depth;
+    bool accepted;                     // same verdict as the bulk validation path
+    std::vector<std::string> violations;  // soundness checks that failed during the replay
+    PDAExplanation() : final_state(Q_START), stack_depth(0), accepted(false) {}
+};
+
 class PDAModule {
 private:
-    std::vector<TCPTrace> dataset;
+    // Working set: records of the shared mapped dataset (or of `synthesized`)
+    std::vector<const TraceView*> dataset;
+    std::vector<uint32_t> dataset_ids;    // interned trace_id of each dataset entry (datasets->ids())
+    DatasetStore::Views source;           // keeps the mapped records alive
+    std::vector<TCPTrace> synthesized;    // owns the strings behind synthesized_views
+    std::vector<std::string_view> synthesized_packets;
+    std::vector<PacketToken> synthesized_tokens;
+    std::vector<TraceView> synthesized_views;
+    std::shared_ptr<DatasetStore> datasets;
     PDA pda;
     PDAMetrics metrics;
     bool strictHandshakeOnly = false;
+    // Optional persistent verdicts: traces already validated under the same grammar are not re-run
+    VerdictStore* verdict_store = nullptr;
+    int reused_verdicts = 0;
+    // Per-connection configurations for feed(); independent of `pda`'s own stack
+    FlowTable flows;
+    FlowMetrics flow_metrics;
+    void replayFlowsSharded(const std::vector<TraceView>& records, size_t concurrent, size_t shards);
     
-    // Process a single packet
-    bool processPacket(const std::string& packet, std::vector<std::string>& operations);
+    // (state, packet, stack top) -> step, from the CFG; compiled into pda.table by buildPDA
+    PDA::Step rule(int state, PacketToken packet, StackSymbol top) const;
+    void compileTransitions();
+    // Process a single packet: one table lookup plus the step's stack action; `note` receives
+    // the step's operation description index
+    bool step(PacketToken packet, uint8_t& note);
     
-    // Validate a sequence of packets
-    bool validateSequence(const std::vector<std::string>& sequence);
+    // Validate a sequence of packets (bulk path: no operation text, no logging)
+    bool validateSequence(PacketRange sequence);
 
 public:
+    // Bump when the CFG or the transition rules change (invalidates stored PDA verdicts)
+    static constexpr uint32_t GRAMMAR_REVISION = 1;
+
     PDAModule();
-    void setStrictHandshake(bool strict) { strictHandshakeOnly = strict; }
+    void setStrictHandshake(bool strict);
+    void setVerdictStore(VerdictStore* store) { verdict_store = store; }
+    // Share parsed datasets with other stages (each module otherwise keeps its own store)
+    void setDatasetStore(std::shared_ptr<DatasetStore> store) { datasets = std::move(store); }
+    int getReusedVerdicts() const { return reused_verdicts; }
     
     // Module pipeline
     void loadDataset(const std::string& filepath);
@@ -47,18 +97,41 @@ public:
     void exportPDAConstruction(const std::string& outPath); // Log rule-driven push/pop
     void testAllTraces();      // Test all traces
     void showStackOperations(const std::vector<std::string>& sequence);
+    // Replay one trace with per-packet operations and soundness checks; on demand only, the
+    // validation paths never produce this; requires buildPDA()
+    PDAExplanation explain(PacketRange sequence);
+    PDAExplanation explain(const std::vector<std::string>& sequence);
     void generateReport();
     // Export Graphviz DOT representing the PDA structure
     std::string exportGraphviz() const;
-    // Filter loaded dataset by a set of trace_ids (e.g., filenames)
-    void filterDatasetByTraceIds(const std::set<std::string>& ids);
+    // Keep only the traces whose interned trace_id (see DatasetStore::ids()) is set in `keep`
+    void filterDataset(const Bitmap& keep);
     // Synthesize traces for given filenames (valid=true for good, false for bad)
     void synthesizeTracesForFilenames(const std::vector<std::string>& filenames, bool valid);
     // Collect trace_ids rejected by PDA for current gated dataset
     std::vector<std::string> collectRejectedIds();
+    // validateSequence for one trace (dataset or streamed), answered from the verdict store when
+    // possible; requires buildPDA()
+    bool validateTrace(const TraceView& t, int& stack_depth);
+
+    // Incremental validation of interleaved connections: one packet of flow `flowKey` at time
+    // `now` (any monotonic unit, the same as the idle timeout's). The verdict is available as
+    // soon as the packet is in, with no trace buffered; requires buildPDA()
+    FlowStatus feed(uint64_t flowKey, PacketToken packet, uint64_t now);
+    // Forget a connection (e.g. once it is closed)
+    void closeFlow(uint64_t flowKey) { flows.remove(flowKey); }
+    // Cap on tracked connections and idle time before one is evicted (drops every flow)
+    void setFlowLimits(size_t maxFlows, uint64_t idleTimeout) { flows.configure(maxFlows, idleTimeout); }
+    // Feed the traces of a file packet by packet, `concurrent` connections interleaved at a
+    // time, and check each flow verdict against validateTrace. With shards > 1 the packets are
+    // dispatched to that many FlowShards workers (the flow limits are split between them)
+    void replayFlows(const std::string& filepath, size_t concurrent, size_t shards = 1);
+    void generateFlowReport();
     
     // Getters
     const PDAMetrics& getMetrics() const { return metrics; }
+    const FlowMetrics& getFlowMetrics() const { return flow_metrics; }
+    const FlowTable& getFlows() const { return flows; }
 };
 
 } // namespace CS311